@@ -12,6 +12,7 @@ ultimateALPR SDK public header
 #define _ULTIMATE_ALPR_SDK_API_PUBLIC_H_
 
 #include <string>
+#include <utility>
 
 #define ULTALPR_SDK_VERSION_MAJOR		3
 #define ULTALPR_SDK_VERSION_MINOR		10
@@ -175,6 +176,22 @@ namespace ultimateAlprSdk
 		virtual ~UltAlprSdkResult();
 #if !defined(SWIG)
 		UltAlprSdkResult& operator=(const UltAlprSdkResult& other) { return operatorAssign(other); }
+		/*! Move constructor. Takes ownership of the phrase and JSON buffers, no string is copied.
+		* The moved-from result is left in the default (empty) state.
+		*/
+		UltAlprSdkResult(UltAlprSdkResult&& other) : UltAlprSdkResult() { swap(other); }
+		/*! Move assignment. Exchanges the buffers with the other result, no string is copied.
+		*/
+		UltAlprSdkResult& operator=(UltAlprSdkResult&& other) { swap(other); return *this; }
+		/*! Exchanges the content of two results without copying the phrase or JSON strings.
+		*/
+		void swap(UltAlprSdkResult& other) {
+			std::swap(code_, other.code_);
+			std::swap(phrase_, other.phrase_);
+			std::swap(json_, other.json_);
+			std::swap(numPlates_, other.numPlates_);
+			std::swap(numCars_, other.numCars_);
+		}
 #endif
 
 		/*! The result code. 0 if success, nonzero otherwise.
@@ -0,0 +1,47 @@
+/* Copyright (C) 2011-2020 Doubango Telecom <https://www.doubango.org>
+* File author: Mamadou DIOP (Doubango Telecom, France).
+* License: For non commercial use only.
+* Source code: https://github.com/DoubangoTelecom/ultimateALPR-SDK
+* WebSite: https://www.doubango.org/webapps/alpr/
+*/
+/*
+SWIG interface for the Python extension only (the C# and Java wrappers are built with the SDK binaries).
+The wrappers in this folder (ultimateALPR-SDK-API-PUBLIC-SWIG_python.cxx/.h and ultimateAlprSdk.py) are generated
+from this file with SWIG 2.0.9, from the "python" folder:
+	swig -c++ -python -I../c++ -o ultimateALPR-SDK-API-PUBLIC-SWIG_python.cxx ultimateALPR-SDK-API-PUBLIC-SWIG.i
+*/
+%module(directors="1") ultimateAlprSdk
+
+%include <stdint.i>
+%include <std_string.i>
+
+%{
+// SDK header
+#include "ultimateALPR-SDK-API-PUBLIC.h"
+%}
+
+// Image data (bytes) passed as "const void*" without copy
+%typemap(in) const void* {
+    // https://docs.python.org/3/c-api/bytes.html#c.PyBytes_AsString
+    // char* PyBytes_AsString(PyObject *o)
+    // Return a pointer to the contents of o. The pointer refers to the internal buffer of o, which consists of len(o) + 1 bytes.
+    // The last byte in the buffer is always null, regardless of whether there are any other null bytes.
+    // The data must not be modified in any way, unless the object was just created using PyBytes_FromStringAndSize(NULL, size).
+    // It must not be deallocated. If o is not a bytes object at all, PyBytes_AsString() returns NULL and raises TypeError.
+    if (PyBytes_Check($input)) {
+      $1 = (void *) PyBytes_AsString($input);
+    }
+    else if (PyString_Check($input)) {
+      $1 = (void *) PyString_AsString($input);
+    }
+}
+
+// Results returned by value are moved (not copied) into the Python object: the phrase and JSON strings
+// are handed over instead of being duplicated. The move constructor is hidden from SWIG (see the public header).
+%typemap(out) ultimateAlprSdk::UltAlprSdkResult {
+    $result = SWIG_NewPointerObj(new $1_ltype(std::move($1)), $&1_descriptor, SWIG_POINTER_OWN | 0);
+}
+
+%feature("director") ultimateAlprSdk::UltAlprSdkParallelDeliveryCallback;
+
+%include "ultimateALPR-SDK-API-PUBLIC.h"
@@ -3561,15 +3561,6 @@ namespace swig {
 #include <string>
 
 
-// To avoid multiple definitions for SwigDirector_UltAlprSdkParallelDeliveryCallback
-// http://swig.10945.n7.nabble.com/Prefix-on-director-classes-td6425.html
-#ifdef SWIGCSHARP
-#		define SwigDirector_UltAlprSdkParallelDeliveryCallback CSharp_SwigDirector_UltAlprSdkParallelDeliveryCallback
-#endif
-#ifdef SWIGJAVA
-#		define SwigDirector_UltAlprSdkParallelDeliveryCallback Java_SwigDirector_UltAlprSdkParallelDeliveryCallback
-#endif
-
 // SDK header
 #include "ultimateALPR-SDK-API-PUBLIC.h"
 
@@ -4594,7 +4585,9 @@ SWIGINTERN PyObject *_wrap_UltAlprSdkEngine_init__SWIG_0(PyObject *SWIGUNUSEDPAR
   }
   arg2 = reinterpret_cast< ultimateAlprSdk::UltAlprSdkParallelDeliveryCallback * >(argp2);
   result = ultimateAlprSdk::UltAlprSdkEngine::init((char const *)arg1,(ultimateAlprSdk::UltAlprSdkParallelDeliveryCallback const *)arg2);
-  resultobj = SWIG_NewPointerObj((new ultimateAlprSdk::UltAlprSdkResult(static_cast< const ultimateAlprSdk::UltAlprSdkResult& >(result))), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN |  0 );
+  {
+    resultobj = SWIG_NewPointerObj(new ultimateAlprSdk::UltAlprSdkResult(std::move(result)), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN | 0);
+  }
   if (alloc1 == SWIG_NEWOBJ) delete[] buf1;
   return resultobj;
 fail:
@@ -4619,7 +4612,9 @@ SWIGINTERN PyObject *_wrap_UltAlprSdkEngine_init__SWIG_1(PyObject *SWIGUNUSEDPAR
   }
   arg1 = reinterpret_cast< char * >(buf1);
   result = ultimateAlprSdk::UltAlprSdkEngine::init((char const *)arg1);
-  resultobj = SWIG_NewPointerObj((new ultimateAlprSdk::UltAlprSdkResult(static_cast< const ultimateAlprSdk::UltAlprSdkResult& >(result))), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN |  0 );
+  {
+    resultobj = SWIG_NewPointerObj(new ultimateAlprSdk::UltAlprSdkResult(std::move(result)), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN | 0);
+  }
   if (alloc1 == SWIG_NEWOBJ) delete[] buf1;
   return resultobj;
 fail:
@@ -4634,7 +4629,9 @@ SWIGINTERN PyObject *_wrap_UltAlprSdkEngine_init__SWIG_2(PyObject *SWIGUNUSEDPAR
   
   if (!PyArg_ParseTuple(args,(char *)":UltAlprSdkEngine_init")) SWIG_fail;
   result = ultimateAlprSdk::UltAlprSdkEngine::init();
-  resultobj = SWIG_NewPointerObj((new ultimateAlprSdk::UltAlprSdkResult(static_cast< const ultimateAlprSdk::UltAlprSdkResult& >(result))), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN |  0 );
+  {
+    resultobj = SWIG_NewPointerObj(new ultimateAlprSdk::UltAlprSdkResult(std::move(result)), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN | 0);
+  }
   return resultobj;
 fail:
   return NULL;
@@ -4692,7 +4689,9 @@ SWIGINTERN PyObject *_wrap_UltAlprSdkEngine_deInit(PyObject *SWIGUNUSEDPARM(self
   
   if (!PyArg_ParseTuple(args,(char *)":UltAlprSdkEngine_deInit")) SWIG_fail;
   result = ultimateAlprSdk::UltAlprSdkEngine::deInit();
-  resultobj = SWIG_NewPointerObj((new ultimateAlprSdk::UltAlprSdkResult(static_cast< const ultimateAlprSdk::UltAlprSdkResult& >(result))), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN |  0 );
+  {
+    resultobj = SWIG_NewPointerObj(new ultimateAlprSdk::UltAlprSdkResult(std::move(result)), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN | 0);
+  }
   return resultobj;
 fail:
   return NULL;
@@ -4766,7 +4765,9 @@ SWIGINTERN PyObject *_wrap_UltAlprSdkEngine_process__SWIG_0(PyObject *SWIGUNUSED
   } 
   arg6 = static_cast< int >(val6);
   result = ultimateAlprSdk::UltAlprSdkEngine::process(arg1,(void const *)arg2,arg3,arg4,arg5,arg6);
-  resultobj = SWIG_NewPointerObj((new ultimateAlprSdk::UltAlprSdkResult(static_cast< const ultimateAlprSdk::UltAlprSdkResult& >(result))), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN |  0 );
+  {
+    resultobj = SWIG_NewPointerObj(new ultimateAlprSdk::UltAlprSdkResult(std::move(result)), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN | 0);
+  }
   return resultobj;
 fail:
   return NULL;
@@ -4831,7 +4832,9 @@ SWIGINTERN PyObject *_wrap_UltAlprSdkEngine_process__SWIG_1(PyObject *SWIGUNUSED
   } 
   arg5 = static_cast< size_t >(val5);
   result = ultimateAlprSdk::UltAlprSdkEngine::process(arg1,(void const *)arg2,arg3,arg4,arg5);
-  resultobj = SWIG_NewPointerObj((new ultimateAlprSdk::UltAlprSdkResult(static_cast< const ultimateAlprSdk::UltAlprSdkResult& >(result))), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN |  0 );
+  {
+    resultobj = SWIG_NewPointerObj(new ultimateAlprSdk::UltAlprSdkResult(std::move(result)), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN | 0);
+  }
   return resultobj;
 fail:
   return NULL;
@@ -4887,7 +4890,9 @@ SWIGINTERN PyObject *_wrap_UltAlprSdkEngine_process__SWIG_2(PyObject *SWIGUNUSED
   } 
   arg4 = static_cast< size_t >(val4);
   result = ultimateAlprSdk::UltAlprSdkEngine::process(arg1,(void const *)arg2,arg3,arg4);
-  resultobj = SWIG_NewPointerObj((new ultimateAlprSdk::UltAlprSdkResult(static_cast< const ultimateAlprSdk::UltAlprSdkResult& >(result))), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN |  0 );
+  {
+    resultobj = SWIG_NewPointerObj(new ultimateAlprSdk::UltAlprSdkResult(std::move(result)), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN | 0);
+  }
   return resultobj;
 fail:
   return NULL;
@@ -5020,7 +5025,9 @@ SWIGINTERN PyObject *_wrap_UltAlprSdkEngine_process__SWIG_3(PyObject *SWIGUNUSED
   } 
   arg11 = static_cast< int >(val11);
   result = ultimateAlprSdk::UltAlprSdkEngine::process(arg1,(void const *)arg2,(void const *)arg3,(void const *)arg4,arg5,arg6,arg7,arg8,arg9,arg10,arg11);
-  resultobj = SWIG_NewPointerObj((new ultimateAlprSdk::UltAlprSdkResult(static_cast< const ultimateAlprSdk::UltAlprSdkResult& >(result))), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN |  0 );
+  {
+    resultobj = SWIG_NewPointerObj(new ultimateAlprSdk::UltAlprSdkResult(std::move(result)), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN | 0);
+  }
   return resultobj;
 fail:
   return NULL;
@@ -5144,7 +5151,9 @@ SWIGINTERN PyObject *_wrap_UltAlprSdkEngine_process__SWIG_4(PyObject *SWIGUNUSED
   } 
   arg10 = static_cast< size_t >(val10);
   result = ultimateAlprSdk::UltAlprSdkEngine::process(arg1,(void const *)arg2,(void const *)arg3,(void const *)arg4,arg5,arg6,arg7,arg8,arg9,arg10);
-  resultobj = SWIG_NewPointerObj((new ultimateAlprSdk::UltAlprSdkResult(static_cast< const ultimateAlprSdk::UltAlprSdkResult& >(result))), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN |  0 );
+  {
+    resultobj = SWIG_NewPointerObj(new ultimateAlprSdk::UltAlprSdkResult(std::move(result)), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN | 0);
+  }
   return resultobj;
 fail:
   return NULL;
@@ -5259,7 +5268,9 @@ SWIGINTERN PyObject *_wrap_UltAlprSdkEngine_process__SWIG_5(PyObject *SWIGUNUSED
   } 
   arg9 = static_cast< size_t >(val9);
   result = ultimateAlprSdk::UltAlprSdkEngine::process(arg1,(void const *)arg2,(void const *)arg3,(void const *)arg4,arg5,arg6,arg7,arg8,arg9);
-  resultobj = SWIG_NewPointerObj((new ultimateAlprSdk::UltAlprSdkResult(static_cast< const ultimateAlprSdk::UltAlprSdkResult& >(result))), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN |  0 );
+  {
+    resultobj = SWIG_NewPointerObj(new ultimateAlprSdk::UltAlprSdkResult(std::move(result)), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN | 0);
+  }
   return resultobj;
 fail:
   return NULL;
@@ -5603,7 +5614,9 @@ SWIGINTERN PyObject *_wrap_UltAlprSdkEngine_requestRuntimeLicenseKey__SWIG_0(PyO
   temp1 = static_cast< bool >(val1);
   arg1 = &temp1;
   result = ultimateAlprSdk::UltAlprSdkEngine::requestRuntimeLicenseKey((bool const &)*arg1);
-  resultobj = SWIG_NewPointerObj((new ultimateAlprSdk::UltAlprSdkResult(static_cast< const ultimateAlprSdk::UltAlprSdkResult& >(result))), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN |  0 );
+  {
+    resultobj = SWIG_NewPointerObj(new ultimateAlprSdk::UltAlprSdkResult(std::move(result)), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN | 0);
+  }
   return resultobj;
 fail:
   return NULL;
@@ -5616,7 +5629,9 @@ SWIGINTERN PyObject *_wrap_UltAlprSdkEngine_requestRuntimeLicenseKey__SWIG_1(PyO
   
   if (!PyArg_ParseTuple(args,(char *)":UltAlprSdkEngine_requestRuntimeLicenseKey")) SWIG_fail;
   result = ultimateAlprSdk::UltAlprSdkEngine::requestRuntimeLicenseKey();
-  resultobj = SWIG_NewPointerObj((new ultimateAlprSdk::UltAlprSdkResult(static_cast< const ultimateAlprSdk::UltAlprSdkResult& >(result))), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN |  0 );
+  {
+    resultobj = SWIG_NewPointerObj(new ultimateAlprSdk::UltAlprSdkResult(std::move(result)), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN | 0);
+  }
   return resultobj;
 fail:
   return NULL;
@@ -5671,7 +5686,9 @@ SWIGINTERN PyObject *_wrap_UltAlprSdkEngine_warmUp(PyObject *SWIGUNUSEDPARM(self
   } 
   arg1 = static_cast< ultimateAlprSdk::ULTALPR_SDK_IMAGE_TYPE >(val1);
   result = ultimateAlprSdk::UltAlprSdkEngine::warmUp(arg1);
-  resultobj = SWIG_NewPointerObj((new ultimateAlprSdk::UltAlprSdkResult(static_cast< const ultimateAlprSdk::UltAlprSdkResult& >(result))), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN |  0 );
+  {
+    resultobj = SWIG_NewPointerObj(new ultimateAlprSdk::UltAlprSdkResult(std::move(result)), SWIGTYPE_p_ultimateAlprSdk__UltAlprSdkResult, SWIG_POINTER_OWN | 0);
+  }
   return resultobj;
 fail:
   return NULL;
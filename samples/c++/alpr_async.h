@@ -0,0 +1,302 @@
+#if !defined(_ULTIMATE_ALPR_SDK_SAMPLES_ASYNC_H_)
+#define _ULTIMATE_ALPR_SDK_SAMPLES_ASYNC_H_
+
+#include <ultimateALPR-SDK-API-PUBLIC.h>
+#include "alpr_utils.h"
+#include "alpr_stats.h"
+#include <stdint.h>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+using namespace ultimateAlprSdk;
+
+/*
+* Callback function used to get the asynchronous results along with the caller's tag
+*/
+struct AlprAsyncDeliveryCallback {
+	virtual ~AlprAsyncDeliveryCallback() { }
+	/*! Called on the processing thread, in submission order, once per submitted frame (dropped frames included).
+	* Never called concurrently by the same processor. */
+	virtual void onNewResult(const uint64_t tag, const UltAlprSdkResult& newResult) const = 0;
+};
+
+/*
+* Callback function used to hand the input buffers back to their owner (camera ring buffer, decoder surface...)
+*/
+struct AlprFrameReleaseCallback {
+	virtual ~AlprFrameReleaseCallback() { }
+	/*! Called on the processing thread as soon as the engine no longer reads the frame's pixels,
+	* before the result is delivered. A dropped (or rejected) frame is released at once, on the thread calling
+	* processAsync(), before it returns: the release callback must be thread-safe when frames can be dropped. */
+	virtual void onRelease(const uint64_t tag, const AlprFrame& frame) const = 0;
+};
+
+/*
+* What to do when a frame is queued while the maximum number of in-flight frames is reached
+*/
+enum AlprDropPolicy {
+	ALPR_DROP_POLICY_BLOCK, // Wait until a frame is delivered
+	ALPR_DROP_POLICY_DROP_OLDEST, // Drop the oldest queued frame (lowest latency)
+	ALPR_DROP_POLICY_DROP_NEWEST, // Drop the frame being queued
+};
+
+// Result code used for the dropped frames. Their JSON is {"dropped_frames": <number of frames dropped so far>}.
+// The total is also available with AlprAsyncProcessor::dropped() and AlprStats::dropped().
+#define ALPR_ASYNC_RESULT_CODE_DROPPED	1
+
+/*
+* Asynchronous front-end for the engine.
+* The engine must be initialized in sequential mode (no UltAlprSdkParallelDeliveryCallback): frames
+* are processed one at a time on a dedicated thread so that each result is matched to the frame (and tag)
+* that produced it, without parsing "frame_id" from the JSON. The caller's thread only queues the frame,
+* which lets decoding, inference and post-processing overlap.
+* The pixels referenced by the frame must stay valid until they're released (see AlprFrameReleaseCallback)
+* or, when no release callback is used, until the result is delivered. The pixels are never copied.
+* The number of in-flight frames is unbounded by default, use setBackpressure() to bound it. Dropped frames are released
+* at once but leave a tombstone (tag, promise, drop count) in the queue so that their result is delivered by the processing
+* thread in submission order like the others.
+* processAsync() may be called from the delivery callback, except when it would have to wait (ALPR_DROP_POLICY_BLOCK with
+* the maximum number of in-flight frames reached, the frame being delivered included): the processing thread can't wait
+* for itself, the frame is rejected.
+*/
+class AlprAsyncProcessor {
+public:
+	AlprAsyncProcessor(const AlprAsyncDeliveryCallback* callback = nullptr)
+		: callback_(callback), running_(true), thread_(&AlprAsyncProcessor::run, this) { }
+	virtual ~AlprAsyncProcessor() {
+		stop();
+	}
+
+	/*
+	* Queues a frame for processing.
+	* @param frame Frame to process.
+	* @param tag Opaque value (frame number, timestamp, pointer...) given back with the result.
+	* @param release Optional callback invoked once the engine is done reading the pixels. Also invoked
+	*	if the frame is rejected or dropped.
+	* @returns a future for the result. Dropped frames get a result with code ALPR_ASYNC_RESULT_CODE_DROPPED,
+	*	rejected frames (processor stopped, called from the delivery callback while full) a negative code.
+	*/
+	std::future<UltAlprSdkResult> processAsync(const AlprFrame& frame, const uint64_t tag = 0, const AlprFrameReleaseCallback* release = nullptr) {
+		AlprAsyncTask task;
+		task.frame = frame;
+		task.tag = tag;
+		task.release = release;
+		std::future<UltAlprSdkResult> future = task.promise.get_future();
+		AlprAsyncRelease released; // Frame dropped by this call, released once the lock is released
+		bool waitOnProcessingThread = false;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			if (maxInFlight_ && dropPolicy_ == ALPR_DROP_POLICY_BLOCK) {
+				if (inFlight() >= maxInFlight_ && std::this_thread::get_id() == thread_.get_id()) {
+					waitOnProcessingThread = true; // Called from the delivery callback: the processing thread can't wait for itself
+				}
+				else {
+					spaceCond_.wait(lock, [this] { return !running_ || inFlight() < maxInFlight_; });
+				}
+			}
+			if (running_ && !waitOnProcessingThread) {
+				bool dropNewest = false;
+				if (maxInFlight_ && inFlight() >= maxInFlight_) {
+					AlprAsyncTask* oldest = nullptr;
+					if (dropPolicy_ == ALPR_DROP_POLICY_DROP_OLDEST) {
+						for (AlprAsyncTask& queued : tasks_) {
+							if (!queued.dropped) {
+								oldest = &queued;
+								break;
+							}
+						}
+					}
+					if (oldest) {
+						markDropped(*oldest, released);
+						--queued_;
+					}
+					else {
+						dropNewest = true; // DROP_NEWEST or nothing queued to drop
+					}
+				}
+				if (dropNewest) {
+					markDropped(task, released);
+				}
+				else {
+					++queued_;
+				}
+				tasks_.push_back(std::move(task));
+				if (stats_) {
+					stats_->setQueueDepth(queued_);
+				}
+				lock.unlock();
+				cond_.notify_one();
+				if (released.release) {
+					released.release->onRelease(released.tag, released.frame);
+				}
+				return future;
+			}
+		}
+		// Stopped or rejected
+		if (release) {
+			release->onRelease(tag, frame);
+		}
+		task.promise.set_value(UltAlprSdkResult::bodyless(-1, waitOnProcessingThread ? "Can't wait for space on the processing thread" : "Processor stopped"));
+		return future;
+	}
+
+	/*
+	* Number of frames queued or being processed
+	*/
+	size_t pending() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return inFlight();
+	}
+
+	/*
+	* Bounds the number of in-flight (queued or being processed) frames.
+	* @param maxInFlight Maximum number of in-flight frames. Zero means unbounded (default).
+	* @param policy What to do with the extra frames.
+	*/
+	void setBackpressure(const size_t maxInFlight, const AlprDropPolicy policy) {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			maxInFlight_ = maxInFlight;
+			dropPolicy_ = policy;
+		}
+		spaceCond_.notify_all();
+	}
+
+	/*
+	* Total number of dropped frames
+	*/
+	uint64_t dropped() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return dropped_;
+	}
+
+	/*
+	* Sets the statistics to update (queue wait, process latency, queue depth, frame counters). May be null.
+	* Must be called before the first frame is queued.
+	*/
+	void setStats(AlprStats* stats) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		stats_ = stats;
+	}
+
+	/*
+	* Processes the frames already queued then stops the processing thread
+	*/
+	void stop() {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			running_ = false;
+		}
+		cond_.notify_all();
+		spaceCond_.notify_all();
+		if (thread_.joinable()) {
+			thread_.join();
+		}
+	}
+
+private:
+	struct AlprAsyncTask {
+		AlprFrame frame;
+		uint64_t tag = 0;
+		const AlprFrameReleaseCallback* release = nullptr;
+		AlprStopwatch queued;
+		std::promise<UltAlprSdkResult> promise;
+		bool dropped = false;
+		uint64_t droppedCount = 0; // Total number of dropped frames when this one was dropped
+	};
+
+	struct AlprAsyncRelease {
+		AlprFrame frame;
+		uint64_t tag = 0;
+		const AlprFrameReleaseCallback* release = nullptr;
+	};
+
+	// Dropped frames waiting in the queue aren't in flight: they're only delivered, not processed
+	inline size_t inFlight() const {
+		return queued_ + (busy_ ? 1 : 0);
+	}
+
+	// Must be called with the lock held. Turns the task into a tombstone: the frame and its release callback are moved
+	// to "released", to be released by the caller once the lock is released.
+	void markDropped(AlprAsyncTask& task, AlprAsyncRelease& released) {
+		released.frame = task.frame;
+		released.tag = task.tag;
+		released.release = task.release;
+		task.frame = AlprFrame();
+		task.release = nullptr;
+		task.dropped = true;
+		task.droppedCount = ++dropped_;
+		if (stats_) {
+			stats_->addDropped();
+		}
+	}
+
+	void run() {
+		for (;;) {
+			AlprAsyncTask task;
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				cond_.wait(lock, [this] { return !running_ || !tasks_.empty(); });
+				if (tasks_.empty()) {
+					return; // stopped and drained
+				}
+				task = std::move(tasks_.front());
+				tasks_.pop_front();
+				if (!task.dropped) {
+					--queued_;
+					busy_ = true;
+					if (stats_) {
+						stats_->setQueueDepth(queued_);
+						stats_->addLatency(AlprStats::ALPR_STATS_STAGE_QUEUE_WAIT, task.queued.micros());
+					}
+				}
+			}
+			if (task.dropped) { // Already released
+				const std::string json = "{\"dropped_frames\":" + std::to_string(task.droppedCount) + "}";
+				UltAlprSdkResult result(ALPR_ASYNC_RESULT_CODE_DROPPED, "Dropped", json.c_str());
+				if (callback_) {
+					callback_->onNewResult(task.tag, result);
+				}
+				task.promise.set_value(std::move(result));
+				continue;
+			}
+			const AlprStopwatch stopwatch;
+			UltAlprSdkResult result = alprProcessFrame(task.frame);
+			if (stats_) {
+				stats_->addLatency(AlprStats::ALPR_STATS_STAGE_PROCESS, stopwatch.micros());
+				stats_->addFrame(result.isOK(), result.numPlates(), result.numCars());
+			}
+			if (task.release) {
+				task.release->onRelease(task.tag, task.frame);
+			}
+			if (callback_) {
+				callback_->onNewResult(task.tag, result);
+			}
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				busy_ = false;
+			}
+			spaceCond_.notify_one();
+			task.promise.set_value(std::move(result));
+		}
+	}
+
+	const AlprAsyncDeliveryCallback* callback_;
+	std::mutex mutex_;
+	std::condition_variable cond_;
+	std::condition_variable spaceCond_;
+	std::deque<AlprAsyncTask> tasks_; // Queued frames and tombstones of the dropped ones, in submission order
+	size_t queued_ = 0; // Queued frames not dropped
+	bool running_;
+	bool busy_ = false;
+	size_t maxInFlight_ = 0;
+	AlprDropPolicy dropPolicy_ = ALPR_DROP_POLICY_BLOCK;
+	uint64_t dropped_ = 0;
+	AlprStats* stats_ = nullptr;
+	std::thread thread_;
+};
+
+#endif /* _ULTIMATE_ALPR_SDK_SAMPLES_ASYNC_H_ */
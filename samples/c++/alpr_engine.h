@@ -0,0 +1,507 @@
+#if !defined(_ULTIMATE_ALPR_SDK_SAMPLES_ENGINE_H_)
+#define _ULTIMATE_ALPR_SDK_SAMPLES_ENGINE_H_
+
+#include <ultimateALPR-SDK-API-PUBLIC.h>
+#include "alpr_utils.h"
+#include "alpr_json.h"
+#include "alpr_plates.h"
+#include "alpr_stats.h"
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+
+using namespace ultimateAlprSdk;
+
+#if ULTALPR_SDK_OS_ANDROID
+#	define ALPR_ENGINE_ASSET_MGR_PARAM() __sdk_android_assetmgr,
+#else
+#	define ALPR_ENGINE_ASSET_MGR_PARAM()
+#endif /* ULTALPR_SDK_OS_ANDROID */
+
+/*
+* Configuration entries applied by each AlprEngineInstance on its own.
+* All other entries configure the engine shared by all instances.
+*/
+struct AlprInstanceConfig {
+	float detectRoi[4] = { 0.f, 0.f, 0.f, 0.f }; // [left, right, top, bottom], all zeros means full frame
+	float detectMinScore = 0.f; // [0.f, 1.f]
+	float recognMinScore = 0.f; // [0.f, 1.f]
+	AlprResultSchema schema; // "result_fields" and "result_precision", used by AlprEngineInstance::serialize()
+
+	// Returns true if "key" is applied by the instance rather than by the shared engine
+	static bool isInstanceKey(const char* key) {
+		return !strcmp(key, "detect_roi") || !strcmp(key, "detect_minscore") || !strcmp(key, "recogn_minscore")
+			|| AlprResultSchema::isSchemaKey(key);
+	}
+
+	// Updates the instance entry "key" using the raw JSON "value". Returns false if the value is invalid.
+	bool set(const char* key, const char* valueBegin, const char* valueEnd) {
+		if (AlprResultSchema::isSchemaKey(key)) {
+			return schema.set(key, valueBegin, valueEnd);
+		}
+		AlprJsonCursor c(valueBegin, valueEnd);
+		if (!strcmp(key, "detect_roi")) {
+			float roi[4] = { 0.f, 0.f, 0.f, 0.f };
+			size_t count = 0;
+			if (!alprJsonReadFloats(c, roi, 4, count) || count != 4) {
+				return false;
+			}
+			memcpy(detectRoi, roi, sizeof(roi));
+			return true;
+		}
+		double value;
+		if (!alprJsonReadNumber(c, value) || value < 0.0 || value > 1.0) {
+			return false;
+		}
+		(!strcmp(key, "detect_minscore") ? detectMinScore : recognMinScore) = static_cast<float>(value);
+		return true;
+	}
+};
+
+/*
+* State of the process-wide engine shared by all instances
+*/
+struct AlprSharedEngine {
+	std::mutex mutex;
+	size_t refCount = 0;
+	std::map<std::string, std::string> config; // canonical values (see canonical()) used to initialize the engine, instance entries excluded
+	float detectMinScore = 0.f;
+	float recognMinScore = 0.f;
+
+	static AlprSharedEngine& instance() {
+		static AlprSharedEngine engine;
+		return engine;
+	}
+
+	// Normalizes a raw JSON value so that the same setting compares equal whatever its spelling: numbers
+	// are reformatted (1 == 1.0), strings are unquoted ("true" == true) and arrays are normalized item by item
+	static std::string canonical(const char* valueBegin, const char* valueEnd) {
+		AlprJsonCursor c(valueBegin, valueEnd);
+		if (c.consume('[')) {
+			std::string text = "[";
+			if (!c.consume(']')) {
+				do {
+					c.skipWs();
+					const char* itemBegin = c.ptr;
+					if (!alprJsonSkipValue(c)) {
+						return std::string(valueBegin, valueEnd);
+					}
+					text += (text.size() > 1 ? "," : "") + canonical(itemBegin, c.ptr);
+				} while (c.consume(','));
+			}
+			return text + "]";
+		}
+		c.skipWs();
+		const char* begin = c.ptr;
+		const char* end = valueEnd;
+		while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\n' || end[-1] == '\r')) {
+			--end;
+		}
+		if ((end - begin) >= 2 && *begin == '"' && end[-1] == '"') {
+			++begin, --end;
+		}
+		const std::string text(begin, end);
+		char* numberEnd = nullptr;
+		const double number = strtod(text.c_str(), &numberEnd);
+		if (!text.empty() && *numberEnd == '\0') {
+			char buffer[32];
+			snprintf(buffer, sizeof(buffer), "%.17g", number);
+			return buffer;
+		}
+		return text;
+	}
+};
+
+/*
+* Per-camera engine handle.
+* The models are loaded once by UltAlprSdkEngine and shared by all instances. Each instance
+* keeps its own region of interest, score thresholds and result schema: the ROI is applied by handing the
+* engine a zero-copy view (pointer offset + stride) on the frame and the coordinates are
+* mapped back to the full frame. Entries that can only be applied by the engine (charset,
+* pyramidal search, classifiers...) must be set to the same values by all instances (same keys, values compared
+* after parsing: 1 and 1.0 are the same), init() fails otherwise.
+* Instances use sequential mode: process() returns the plates for the frame it was given.
+* Once init() returned, process(), updateConfig(), config() and serialize() may be called from several threads at the
+* same time. init() and deInit() must not overlap process() calls on the same instance.
+*/
+class AlprEngineInstance {
+public:
+	AlprEngineInstance() { }
+	virtual ~AlprEngineInstance() {
+		deInit();
+	}
+
+	/*
+	* Creates the instance. The first instance initializes the shared engine with "jsonConfig".
+	* @param jsonConfig Same JSON configuration as UltAlprSdkEngine::init.
+	* @returns a result
+	*/
+	UltAlprSdkResult init(const char* jsonConfig) {
+		if (initialized_) {
+			return UltAlprSdkResult::bodyless(-1, "Already initialized");
+		}
+		AlprInstanceConfig config;
+		std::map<std::string, std::string> engineConfig;
+		std::string engineJson, conflicts;
+		bool valid = true;
+		if (jsonConfig && *jsonConfig) {
+			valid = alprJsonForEachMember(jsonConfig, [&](const char* key, const char* valueBegin, const char* valueEnd) {
+				if (AlprInstanceConfig::isInstanceKey(key)) {
+					valid &= config.set(key, valueBegin, valueEnd);
+					if (!strcmp(key, "detect_roi")) {
+						return; // Applied by the instance, the shared engine always sees the full frame
+					}
+					if (AlprResultSchema::isSchemaKey(key)) {
+						return; // Unknown to the engine
+					}
+				}
+				engineConfig[key] = AlprSharedEngine::canonical(valueBegin, valueEnd);
+				engineJson += std::string(engineJson.empty() ? "" : ",") + "\"" + key + "\":" + std::string(valueBegin, valueEnd);
+			}) && valid;
+		}
+		if (!valid) {
+			return UltAlprSdkResult::bodyless(-1, "Invalid JSON configuration");
+		}
+
+		AlprSharedEngine& shared = AlprSharedEngine::instance();
+		std::lock_guard<std::mutex> lock(shared.mutex);
+		if (initialized_) { // Concurrent init()
+			return UltAlprSdkResult::bodyless(-1, "Already initialized");
+		}
+		if (shared.refCount == 0) {
+			UltAlprSdkResult result = UltAlprSdkEngine::init(
+				ALPR_ENGINE_ASSET_MGR_PARAM()
+				("{" + engineJson + "}").c_str()
+			);
+			if (!result.isOK()) {
+				return result;
+			}
+			shared.config = engineConfig;
+			shared.detectMinScore = config.detectMinScore;
+			shared.recognMinScore = config.recognMinScore;
+		}
+		else {
+			// Both ways: an entry only set by the other instances would silently apply to this one too
+			for (const auto& entry : engineConfig) {
+				if (AlprInstanceConfig::isInstanceKey(entry.first.c_str())) {
+					continue;
+				}
+				const auto it = shared.config.find(entry.first);
+				if (it == shared.config.end() || it->second != entry.second) {
+					conflicts += (conflicts.empty() ? "" : ", ") + entry.first;
+				}
+			}
+			for (const auto& entry : shared.config) {
+				if (!AlprInstanceConfig::isInstanceKey(entry.first.c_str()) && engineConfig.find(entry.first) == engineConfig.end()) {
+					conflicts += (conflicts.empty() ? "" : ", ") + entry.first;
+				}
+			}
+			// The engine drops candidates below its own thresholds, instances can only be stricter
+			if (config.detectMinScore < shared.detectMinScore) {
+				conflicts += std::string(conflicts.empty() ? "" : ", ") + "detect_minscore";
+			}
+			if (config.recognMinScore < shared.recognMinScore) {
+				conflicts += std::string(conflicts.empty() ? "" : ", ") + "recogn_minscore";
+			}
+			if (!conflicts.empty()) {
+				ULTALPR_SDK_PRINT_ERROR("Entries differ from the shared engine: %s", conflicts.c_str());
+				return UltAlprSdkResult::bodyless(-1, "Configuration differs from the shared engine");
+			}
+		}
+		++shared.refCount;
+		{
+			std::lock_guard<std::mutex> configLock(configMutex_);
+			config_ = config;
+		}
+		initialized_ = true;
+		return UltAlprSdkResult::bodylessOK();
+	}
+
+	/*
+	* Releases the instance. The last instance deinitializes the shared engine.
+	* @returns a result
+	*/
+	UltAlprSdkResult deInit() {
+		AlprSharedEngine& shared = AlprSharedEngine::instance();
+		std::lock_guard<std::mutex> lock(shared.mutex);
+		if (!initialized_.exchange(false)) {
+			return UltAlprSdkResult::bodylessOK();
+		}
+		if (--shared.refCount == 0) {
+			shared.config.clear();
+			return UltAlprSdkEngine::deInit();
+		}
+		return UltAlprSdkResult::bodylessOK();
+	}
+
+	/*
+	* Performs ANPR detection and recognition on the instance's region of interest.
+	* @param frame Frame to process. Must be upright (EXIF orientation 1) unless the region of interest is the full frame.
+	* @param plates Plates found in the frame, with coordinates relative to the full frame.
+	* @returns the result from the engine. Its JSON is relative to the region of interest, use "plates" instead.
+	*	The code is nonzero if the region of interest is outside the frame or the frame is rotated (see crop()).
+	*/
+	UltAlprSdkResult process(const AlprFrame& frame, AlprPlates& plates) {
+		if (!initialized_) {
+			return UltAlprSdkResult::bodyless(-1, "Not initialized");
+		}
+		const AlprInstanceConfig config = this->config(); // Snapshot: updateConfig() takes effect between frames
+		plates.plates.clear();
+		AlprFrame view;
+		size_t left, top;
+		UltAlprSdkResult result = crop(frame, config.detectRoi, view, left, top)
+			? processRegion(view, left, top, config, plates)
+			: UltAlprSdkResult::bodyless(-1, cropError(frame));
+		if (stats_) {
+			stats_->addFrame(result.isOK(), plates.size(), carCount(plates));
+		}
+		return result;
+	}
+
+	/*
+	* Performs ANPR detection and recognition on a list of regions of interest, for this frame only.
+	* The instance's "detect_roi" is ignored. Each region is handed to the engine as a zero-copy view and the
+	* coordinates are mapped back to the full frame. A plate found in several overlapping regions is only
+	* returned once. Use this when upstream triggers (motion, vehicle detector...) already know where to look.
+	* @param frame Frame to process. Must be upright (EXIF orientation 1).
+	* @param rois Regions of interest, each one is [left, right, top, bottom] in pixels. Empty regions, or regions
+	*	entirely outside the frame, are skipped.
+	* @param count Number of regions. Zero means nothing to process.
+	* @param plates Plates found in the regions, with coordinates relative to the full frame.
+	* @returns the result from the engine for the last region, or the first failure.
+	*/
+	UltAlprSdkResult process(const AlprFrame& frame, const float (*rois)[4], const size_t count, AlprPlates& plates) {
+		if (!initialized_) {
+			return UltAlprSdkResult::bodyless(-1, "Not initialized");
+		}
+		const AlprInstanceConfig config = this->config();
+		UltAlprSdkResult result = UltAlprSdkResult::bodylessOK();
+		plates.plates.clear();
+		for (size_t i = 0; i < count; ++i) {
+			if (rois[i][1] <= rois[i][0] || rois[i][3] <= rois[i][2]) {
+				continue; // Empty region, crop() would process the full frame
+			}
+			AlprFrame view;
+			size_t left, top;
+			if (!crop(frame, rois[i], view, left, top)) {
+				if (frame.exifOrientation != 1) {
+					result = UltAlprSdkResult::bodyless(-1, cropError(frame));
+					break;
+				}
+				continue; // Outside the frame
+			}
+			const size_t first = plates.plates.size();
+			if (!(result = processRegion(view, left, top, config, plates)).isOK()) {
+				break;
+			}
+			// Remove the duplicates coming from overlapping regions
+			for (size_t k = first; k < plates.plates.size(); ) {
+				bool duplicate = false;
+				for (size_t j = 0; j < first && !duplicate; ++j) {
+					if (iou(plates.plates[j].warpedBox, plates.plates[k].warpedBox) > 0.5f) {
+						if (plates.plates[k].recognitionConfidence() > plates.plates[j].recognitionConfidence()) {
+							plates.plates[j] = plates.plates[k];
+						}
+						duplicate = true;
+					}
+				}
+				if (duplicate) {
+					plates.plates.erase(plates.plates.begin() + k);
+				}
+				else {
+					++k;
+				}
+			}
+		}
+		if (stats_) {
+			stats_->addFrame(result.isOK(), plates.size(), carCount(plates));
+		}
+		return result;
+	}
+
+	/*
+	* Applies the hot-changeable entries of "jsonPatch" without reloading the models. The new
+	* values are used starting with the next frame, all at once. Entries that can only be applied by
+	* reinitializing the shared engine are left unchanged and reported.
+	* Hot-changeable entries: detect_roi, detect_minscore and recogn_minscore (as long as the thresholds
+	* are not lower than the ones used to initialize the shared engine).
+	* @param jsonPatch JSON object with the entries to change, e.g. {"detect_roi": [0, 1280, 200, 720]}
+	* @returns a result. Its JSON lists the "applied" entries and the "restart_required" ones.
+	*	The code is nonzero (and nothing is applied) if an entry has an invalid value.
+	*/
+	UltAlprSdkResult updateConfig(const char* jsonPatch) {
+		if (!initialized_) {
+			return UltAlprSdkResult::bodyless(-1, "Not initialized");
+		}
+		AlprInstanceConfig config = this->config();
+		std::string applied, restartRequired;
+		bool valid = true;
+		AlprSharedEngine& shared = AlprSharedEngine::instance();
+		std::unique_lock<std::mutex> sharedLock(shared.mutex);
+		valid = alprJsonForEachMember(jsonPatch, [&](const char* key, const char* valueBegin, const char* valueEnd) {
+			std::string& list = AlprInstanceConfig::isInstanceKey(key) ? applied : restartRequired;
+			if (AlprInstanceConfig::isInstanceKey(key)) {
+				valid &= config.set(key, valueBegin, valueEnd);
+			}
+			else {
+				const auto it = shared.config.find(key);
+				if (it != shared.config.end() && it->second == AlprSharedEngine::canonical(valueBegin, valueEnd)) {
+					return; // Unchanged
+				}
+			}
+			list += std::string(list.empty() ? "\"" : ",\"") + key + "\"";
+		}) && valid;
+		if (!valid) {
+			return UltAlprSdkResult::bodyless(-1, "Invalid JSON patch");
+		}
+		if (config.detectMinScore < shared.detectMinScore || config.recognMinScore < shared.recognMinScore) {
+			return UltAlprSdkResult::bodyless(-1, "Scores lower than the shared engine's require a restart");
+		}
+		sharedLock.unlock();
+		{
+			std::lock_guard<std::mutex> configLock(configMutex_);
+			config_ = config;
+		}
+		const std::string json = "{\"applied\":[" + applied + "],\"restart_required\":[" + restartRequired + "]}";
+		return UltAlprSdkResult(0, "OK", json.c_str());
+	}
+
+	/*
+	* Sets the statistics to update (process, engine and parse latencies, frame counters). May be null.
+	* Several instances may share the same statistics. Must be called before the first frame is processed.
+	*/
+	inline void setStats(AlprStats* stats) { stats_ = stats; }
+	inline AlprStats* stats() const { return stats_; }
+
+	AlprInstanceConfig config() {
+		std::lock_guard<std::mutex> configLock(configMutex_);
+		return config_;
+	}
+
+	/*
+	* Serializes the plates using the instance's result schema ("result_fields", "result_precision").
+	*/
+	void serialize(const AlprPlates& plates, std::string& json) {
+		AlprResultSchema schema;
+		{
+			std::lock_guard<std::mutex> configLock(configMutex_);
+			schema = config_.schema;
+		}
+		alprSerializePlates(plates, schema, json);
+	}
+
+	/*
+	* Makes a view on the region [left, right, top, bottom] of the frame without copying the pixels.
+	* Only the top-left corner is moved: the strides are unchanged. A region with all zeros is the full frame.
+	* @returns false if the region is empty once clamped to the frame, or if the frame is rotated (EXIF orientation != 1):
+	*	the region would have to be mapped to the stored pixels and the plates back, which isn't supported.
+	*/
+	static bool crop(const AlprFrame& frame, const float (&roi)[4], AlprFrame& view, size_t& left, size_t& top) {
+		left = top = 0;
+		view = frame;
+		if (roi[0] == 0.f && roi[1] == 0.f && roi[2] == 0.f && roi[3] == 0.f) {
+			return true;
+		}
+		if (frame.exifOrientation != 1) {
+			return false;
+		}
+		const bool planar = frame.isPlanar();
+		// Chroma subsampling requires even offsets for the planar formats
+		left = static_cast<size_t>(roi[0] < 0.f ? 0.f : roi[0]) & (planar ? ~size_t(1) : ~size_t(0));
+		top = static_cast<size_t>(roi[2] < 0.f ? 0.f : roi[2]) & (planar ? ~size_t(1) : ~size_t(0));
+		const size_t right = (std::min)(static_cast<size_t>(roi[1] < 0.f ? 0.f : roi[1]), frame.width);
+		const size_t bottom = (std::min)(static_cast<size_t>(roi[3] < 0.f ? 0.f : roi[3]), frame.height);
+		if (right <= left || bottom <= top) {
+			left = top = 0;
+			return false;
+		}
+		view.width = right - left;
+		view.height = bottom - top;
+		if (planar) {
+			const bool nv = (frame.type == ULTALPR_SDK_IMAGE_TYPE_NV12 || frame.type == ULTALPR_SDK_IMAGE_TYPE_NV21);
+			const size_t hShift = (frame.type == ULTALPR_SDK_IMAGE_TYPE_YUV444P) ? 0 : 1;
+			const size_t vShift = (frame.type == ULTALPR_SDK_IMAGE_TYPE_YUV444P || frame.type == ULTALPR_SDK_IMAGE_TYPE_YUV422P) ? 0 : 1;
+			const size_t uvPixelStride = frame.uvPixelStrideInBytes ? frame.uvPixelStrideInBytes : (nv ? 2 : 1);
+			view.data[0] = static_cast<const uint8_t*>(frame.data[0]) + (top * frame.strides[0]) + left;
+			view.data[1] = static_cast<const uint8_t*>(frame.data[1]) + ((top >> vShift) * frame.strides[1]) + ((left >> hShift) * uvPixelStride);
+			view.data[2] = static_cast<const uint8_t*>(frame.data[2]) + ((top >> vShift) * frame.strides[2]) + ((left >> hShift) * uvPixelStride);
+		}
+		else {
+			const size_t stride = frame.strides[0] ? frame.strides[0] : frame.width;
+			view.strides[0] = stride;
+			view.data[0] = static_cast<const uint8_t*>(frame.data[0]) + (((top * stride) + left) * alprBytesPerSample(frame.type));
+		}
+		return true;
+	}
+
+private:
+	// Reason why crop() failed
+	static const char* cropError(const AlprFrame& frame) {
+		return (frame.exifOrientation != 1) ? "Regions of interest require an upright frame (EXIF orientation 1)" : "Region of interest outside the frame";
+	}
+
+	// Processes the view on a region of the frame, at (left, top), and appends the plates (full-frame coordinates) to "plates"
+	UltAlprSdkResult processRegion(const AlprFrame& view, const size_t left, const size_t top, const AlprInstanceConfig& config, AlprPlates& plates) {
+		AlprStopwatch stopwatch;
+		UltAlprSdkResult result = alprProcessFrame(view);
+		if (stats_) {
+			stats_->addLatency(AlprStats::ALPR_STATS_STAGE_PROCESS, stopwatch.micros());
+			stopwatch = AlprStopwatch();
+		}
+		if (!result.isOK()) {
+			return result;
+		}
+		AlprPlates regionPlates; // Local: process() may be called from several threads
+		if (!alprParsePlates(result, regionPlates)) {
+			return UltAlprSdkResult::bodyless(-1, "Failed to parse the result");
+		}
+		if (stats_) {
+			stats_->addLatency(AlprStats::ALPR_STATS_STAGE_PARSE, stopwatch.micros());
+			if (regionPlates.durationMillis >= 0.0) {
+				stats_->addLatency(AlprStats::ALPR_STATS_STAGE_ENGINE, regionPlates.durationMillis * 1000.0);
+			}
+		}
+		plates.frameId = regionPlates.frameId;
+		for (AlprPlate& plate : regionPlates.plates) {
+			if (plate.detectionConfidence() < config.detectMinScore * 100.f || plate.recognitionConfidence() < config.recognMinScore * 100.f) {
+				continue;
+			}
+			for (size_t k = 0; k < 8; k += 2) {
+				plate.warpedBox[k] += left, plate.warpedBox[k + 1] += top;
+				if (plate.hasCar) {
+					plate.carWarpedBox[k] += left, plate.carWarpedBox[k + 1] += top;
+				}
+			}
+			plates.plates.push_back(plate);
+		}
+		return result;
+	}
+
+	static size_t carCount(const AlprPlates& plates) {
+		size_t count = 0;
+		for (const AlprPlate& plate : plates) {
+			count += plate.hasCar ? 1 : 0;
+		}
+		return count;
+	}
+
+	// Intersection over union of the axis-aligned bounding boxes of two warped boxes
+	static float iou(const float (&a)[8], const float (&b)[8]) {
+		float ax0 = a[0], ax1 = a[0], ay0 = a[1], ay1 = a[1], bx0 = b[0], bx1 = b[0], by0 = b[1], by1 = b[1];
+		for (size_t k = 2; k < 8; k += 2) {
+			ax0 = (std::min)(ax0, a[k]), ax1 = (std::max)(ax1, a[k]), ay0 = (std::min)(ay0, a[k + 1]), ay1 = (std::max)(ay1, a[k + 1]);
+			bx0 = (std::min)(bx0, b[k]), bx1 = (std::max)(bx1, b[k]), by0 = (std::min)(by0, b[k + 1]), by1 = (std::max)(by1, b[k + 1]);
+		}
+		const float inter = (std::max)(0.f, (std::min)(ax1, bx1) - (std::max)(ax0, bx0)) * (std::max)(0.f, (std::min)(ay1, by1) - (std::max)(ay0, by0));
+		const float uni = ((ax1 - ax0) * (ay1 - ay0)) + ((bx1 - bx0) * (by1 - by0)) - inter;
+		return uni > 0.f ? (inter / uni) : 0.f;
+	}
+
+	std::atomic<bool> initialized_{ false };
+	AlprStats* stats_ = nullptr;
+	std::mutex configMutex_;
+	AlprInstanceConfig config_;
+};
+
+#endif /* _ULTIMATE_ALPR_SDK_SAMPLES_ENGINE_H_ */
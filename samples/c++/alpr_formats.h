@@ -0,0 +1,182 @@
+#if !defined(_ULTIMATE_ALPR_SDK_SAMPLES_FORMATS_H_)
+#define _ULTIMATE_ALPR_SDK_SAMPLES_FORMATS_H_
+
+#include <ultimateALPR-SDK-API-PUBLIC.h>
+#include "alpr_utils.h"
+#include "alpr_memory.h"
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define ALPR_FORMATS_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	include <arm_neon.h>
+#	define ALPR_FORMATS_NEON 1
+#endif
+
+using namespace ultimateAlprSdk;
+
+/*
+* Camera formats not listed in ULTALPR_SDK_IMAGE_TYPE. They're mapped to the closest
+* engine type by alprWrapCameraFrame(), copying as little as possible.
+*/
+enum AlprCameraFormat {
+	/*! Packed YUV 4:2:2, Y0 U0 Y1 V0. Most USB/V4L2 cameras (V4L2_PIX_FMT_YUYV). */
+	ALPR_CAMERA_FORMAT_YUYV,
+	/*! Packed YUV 4:2:2, U0 Y0 V0 Y1 (V4L2_PIX_FMT_UYVY). */
+	ALPR_CAMERA_FORMAT_UYVY,
+	/*! Semi-planar YUV 4:2:2: Y plane followed by an interleaved U/V plane at full height (V4L2_PIX_FMT_NV16). Zero-copy. */
+	ALPR_CAMERA_FORMAT_NV16,
+	/*! Semi-planar YUV 4:2:0, 16-bit little-endian samples with 10 significant MSBs (hardware decoders, HDR). */
+	ALPR_CAMERA_FORMAT_P010,
+};
+
+/*
+* Splits even and odd bytes: even[i] = src[2 * i], odd[i] = src[2 * i + 1]. "even" or "odd" may be null.
+*/
+static inline void alprDeinterleave2(const uint8_t* src, uint8_t* even, uint8_t* odd, const size_t count)
+{
+	size_t i = 0;
+#if ALPR_FORMATS_SSE2
+	const __m128i mask = _mm_set1_epi16(0x00ff);
+	for (; i + 16 <= count; i += 16) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i << 1)));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i << 1) + 16));
+		if (even) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(even + i), _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+		}
+		if (odd) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(odd + i), _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+		}
+	}
+#elif ALPR_FORMATS_NEON
+	for (; i + 16 <= count; i += 16) {
+		const uint8x16x2_t v = vld2q_u8(src + (i << 1));
+		if (even) {
+			vst1q_u8(even + i, v.val[0]);
+		}
+		if (odd) {
+			vst1q_u8(odd + i, v.val[1]);
+		}
+	}
+#endif
+	for (; i < count; ++i) {
+		if (even) {
+			even[i] = src[(i << 1)];
+		}
+		if (odd) {
+			odd[i] = src[(i << 1) + 1];
+		}
+	}
+}
+
+/*
+* Describes a camera frame as an engine frame.
+* - NV16: zero-copy, mapped to ULTALPR_SDK_IMAGE_TYPE_YUV422P with 2-byte chroma pixel stride.
+* - YUYV/UYVY: luma deinterleaved with SIMD into a pooled buffer. With "lumaOnly" the frame is mapped to
+*	ULTALPR_SDK_IMAGE_TYPE_Y (half the bytes of the camera frame, enough for detection and recognition),
+*	otherwise the chroma is deinterleaved too and the frame is mapped to ULTALPR_SDK_IMAGE_TYPE_YUV422P
+*	(required for Vehicle Color Recognition).
+* - P010: the 8 MSBs of each sample are extracted into a pooled buffer, mapped to ULTALPR_SDK_IMAGE_TYPE_Y
+*	or ULTALPR_SDK_IMAGE_TYPE_YUV420P.
+* @param format Camera format.
+* @param planes Packed data in planes[0]. For semi-planar formats, Y in planes[0] and interleaved UV in planes[1].
+* @param strides Strides in bytes, same layout as "planes".
+* @param width Width in pixels. Must be even.
+* @param height Height in pixels. Must be even for P010.
+* @param lumaOnly Whether to skip the chroma samples.
+* @param pool Pool used for the converted planes.
+* @param frame The engine frame.
+* @param scratch Buffer acquired from "pool", null if none. Recycle it once the engine is done reading the frame.
+* @returns true if succeeded, false otherwise.
+*/
+static inline bool alprWrapCameraFrame(const AlprCameraFormat format, const void* const planes[2], const size_t strides[2],
+	const size_t width, const size_t height, const bool lumaOnly, AlprBufferPool& pool, AlprFrame& frame, void*& scratch)
+{
+	scratch = nullptr;
+	if (!planes || !planes[0] || !strides || (width & 1) || !height || (format == ALPR_CAMERA_FORMAT_P010 && (height & 1))) {
+		ULTALPR_SDK_PRINT_ERROR("Invalid camera frame (%zu x %zu)", width, height);
+		return false;
+	}
+	frame = AlprFrame();
+	frame.width = width;
+	frame.height = height;
+
+	if (format == ALPR_CAMERA_FORMAT_NV16) {
+		if (!planes[1]) {
+			return false;
+		}
+		frame.type = lumaOnly ? ULTALPR_SDK_IMAGE_TYPE_Y : ULTALPR_SDK_IMAGE_TYPE_YUV422P;
+		frame.data[0] = planes[0];
+		frame.strides[0] = strides[0];
+		if (!lumaOnly) {
+			frame.data[1] = planes[1];
+			frame.data[2] = static_cast<const uint8_t*>(planes[1]) + 1;
+			frame.strides[1] = frame.strides[2] = strides[1];
+			frame.uvPixelStrideInBytes = 2;
+		}
+		return true;
+	}
+
+	// Planes for the converted frame, in one pooled buffer
+	const bool is420 = (format == ALPR_CAMERA_FORMAT_P010);
+	const size_t chromaWidth = width >> 1;
+	const size_t chromaHeight = is420 ? (height >> 1) : height;
+	const size_t lumaSize = width * height;
+	const size_t chromaSize = lumaOnly ? 0 : (chromaWidth * chromaHeight);
+	const size_t tmpSize = lumaOnly ? 0 : width; // one row of interleaved chroma
+	uint8_t* y = static_cast<uint8_t*>(scratch = pool.acquire(lumaSize + (chromaSize << 1) + tmpSize));
+	if (!y) {
+		return false;
+	}
+	uint8_t* u = y + lumaSize;
+	uint8_t* v = u + chromaSize;
+	uint8_t* tmp = v + chromaSize;
+
+	const uint8_t* src = static_cast<const uint8_t*>(planes[0]);
+	for (size_t j = 0; j < height; ++j, src += strides[0]) {
+		switch (format) {
+		case ALPR_CAMERA_FORMAT_YUYV:
+			alprDeinterleave2(src, y + (j * width), lumaOnly ? nullptr : tmp, width);
+			break;
+		case ALPR_CAMERA_FORMAT_UYVY:
+			alprDeinterleave2(src, lumaOnly ? nullptr : tmp, y + (j * width), width);
+			break;
+		default: // P010: little-endian, MSBs in the odd bytes
+			alprDeinterleave2(src, nullptr, y + (j * width), width);
+			break;
+		}
+		if (!lumaOnly && !is420) {
+			alprDeinterleave2(tmp, u + (j * chromaWidth), v + (j * chromaWidth), chromaWidth);
+		}
+	}
+	if (!lumaOnly && is420) {
+		if (!planes[1]) {
+			pool.recycle(scratch);
+			scratch = nullptr;
+			return false;
+		}
+		src = static_cast<const uint8_t*>(planes[1]);
+		for (size_t j = 0; j < chromaHeight; ++j, src += strides[1]) {
+			alprDeinterleave2(src, nullptr, tmp, width); // U0 V0 U1 V1... MSBs
+			alprDeinterleave2(tmp, u + (j * chromaWidth), v + (j * chromaWidth), chromaWidth);
+		}
+	}
+
+	frame.data[0] = y;
+	frame.strides[0] = width;
+	if (lumaOnly) {
+		frame.type = ULTALPR_SDK_IMAGE_TYPE_Y;
+	}
+	else {
+		frame.type = is420 ? ULTALPR_SDK_IMAGE_TYPE_YUV420P : ULTALPR_SDK_IMAGE_TYPE_YUV422P;
+		frame.data[1] = u;
+		frame.data[2] = v;
+		frame.strides[1] = frame.strides[2] = chromaWidth;
+		frame.uvPixelStrideInBytes = 1;
+	}
+	return true;
+}
+
+#endif /* _ULTIMATE_ALPR_SDK_SAMPLES_FORMATS_H_ */
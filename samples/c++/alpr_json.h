@@ -0,0 +1,253 @@
+#if !defined(_ULTIMATE_ALPR_SDK_SAMPLES_JSON_H_)
+#define _ULTIMATE_ALPR_SDK_SAMPLES_JSON_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+/*
+* Minimal single-pass JSON cursor. Only what's needed to walk the result: no DOM, no allocation.
+*/
+struct AlprJsonCursor {
+	const char* ptr;
+	const char* end;
+	bool error = false;
+
+	AlprJsonCursor(const char* json) : ptr(json), end(json + (json ? strlen(json) : 0)) { }
+	AlprJsonCursor(const char* begin, const char* end_) : ptr(begin), end(end_) { }
+
+	inline void skipWs() {
+		while (ptr < end && (*ptr == ' ' || *ptr == '\t' || *ptr == '\n' || *ptr == '\r')) {
+			++ptr;
+		}
+	}
+	inline bool consume(const char c) {
+		skipWs();
+		if (ptr < end && *ptr == c) {
+			++ptr;
+			return true;
+		}
+		return false;
+	}
+	inline bool expect(const char c) {
+		if (!consume(c)) {
+			error = true;
+		}
+		return !error;
+	}
+	inline bool peek(const char c) {
+		skipWs();
+		return (ptr < end && *ptr == c);
+	}
+};
+
+// Reads a string into "out" (truncated to "outSize" - 1 bytes). "out" may be null to skip the string.
+static inline bool alprJsonReadString(AlprJsonCursor& c, char* out, const size_t outSize)
+{
+	if (!c.expect('"')) {
+		return false;
+	}
+	size_t len = 0;
+	while (c.ptr < c.end && *c.ptr != '"') {
+		char ch = *c.ptr++;
+		if (ch == '\\' && c.ptr < c.end) {
+			ch = *c.ptr++;
+			switch (ch) {
+			case 'n': ch = '\n'; break;
+			case 't': ch = '\t'; break;
+			case 'r': ch = '\r'; break;
+			case 'b': ch = '\b'; break;
+			case 'f': ch = '\f'; break;
+			case 'u': { // The SDK outputs raw UTF-8: only the ASCII escapes (e.g. control characters) are decoded
+				ch = '?';
+				if ((c.end - c.ptr) >= 4) {
+					char hex[5] = { c.ptr[0], c.ptr[1], c.ptr[2], c.ptr[3], '\0' };
+					char* hexEnd = nullptr;
+					const unsigned long code = strtoul(hex, &hexEnd, 16);
+					if (hexEnd == hex + 4 && code < 0x80) {
+						ch = static_cast<char>(code);
+					}
+					c.ptr += 4;
+				}
+				else {
+					c.ptr = c.end;
+				}
+				break;
+			}
+			default: break; // '"', '\\', '/'
+			}
+		}
+		if (out && (len + 1) < outSize) {
+			out[len++] = ch;
+		}
+	}
+	if (out && outSize) {
+		out[len] = '\0';
+	}
+	return c.expect('"');
+}
+
+// Reads an object key and the colon following it
+static inline bool alprJsonReadKey(AlprJsonCursor& c, char* key, const size_t keySize)
+{
+	return alprJsonReadString(c, key, keySize) && c.expect(':');
+}
+
+static inline bool alprJsonReadNumber(AlprJsonCursor& c, double& value)
+{
+	c.skipWs();
+	char* numEnd = nullptr;
+	value = strtod(c.ptr, &numEnd);
+	if (numEnd == c.ptr || numEnd > c.end) {
+		c.error = true;
+		return false;
+	}
+	c.ptr = numEnd;
+	return true;
+}
+
+static inline bool alprJsonSkipValue(AlprJsonCursor& c)
+{
+	c.skipWs();
+	if (c.ptr >= c.end) {
+		c.error = true;
+		return false;
+	}
+	switch (*c.ptr) {
+	case '"':
+		return alprJsonReadString(c, nullptr, 0);
+	case '{':
+	case '[': {
+		const char close = (*c.ptr == '{') ? '}' : ']';
+		++c.ptr;
+		if (c.consume(close)) {
+			return true;
+		}
+		do {
+			if (close == '}' && !alprJsonReadKey(c, nullptr, 0)) {
+				return false;
+			}
+			if (!alprJsonSkipValue(c)) {
+				return false;
+			}
+		} while (c.consume(','));
+		return c.expect(close);
+	}
+	default: // number, true, false, null
+		while (c.ptr < c.end && *c.ptr != ',' && *c.ptr != '}' && *c.ptr != ']' && *c.ptr != ' ' && *c.ptr != '\n' && *c.ptr != '\r' && *c.ptr != '\t') {
+			++c.ptr;
+		}
+		return true;
+	}
+}
+
+static inline bool alprJsonReadFloats(AlprJsonCursor& c, float* out, const size_t maxCount, size_t& count)
+{
+	count = 0;
+	if (!c.expect('[')) {
+		return false;
+	}
+	if (c.consume(']')) {
+		return true;
+	}
+	do {
+		double value;
+		if (!alprJsonReadNumber(c, value)) {
+			return false;
+		}
+		if (count < maxCount) {
+			out[count++] = static_cast<float>(value);
+		}
+	} while (c.consume(','));
+	return c.expect(']');
+}
+
+/*
+* Calls "fn(key, valueBegin, valueEnd)" for each top-level member of a JSON object.
+* "valueBegin" and "valueEnd" delimit the raw (unparsed) text of the value.
+*/
+template <typename Fn>
+static inline bool alprJsonForEachMember(const char* json, Fn fn)
+{
+	char key[64];
+	AlprJsonCursor c(json);
+	if (!c.expect('{')) {
+		return false;
+	}
+	if (c.consume('}')) {
+		return true;
+	}
+	do {
+		if (!alprJsonReadKey(c, key, sizeof(key))) {
+			return false;
+		}
+		c.skipWs();
+		const char* valueBegin = c.ptr;
+		if (!alprJsonSkipValue(c)) {
+			return false;
+		}
+		fn(key, valueBegin, c.ptr);
+	} while (c.consume(','));
+	return c.expect('}');
+}
+
+/*
+* Returns true if "value" is a number as defined by JSON: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+* Unlike strtod(), rejects "inf", "nan", hexadecimal numbers and leading whitespace or "+".
+*/
+static inline bool alprJsonIsNumber(const char* value)
+{
+	const char* p = value;
+	if (!p) {
+		return false;
+	}
+	p += (*p == '-') ? 1 : 0;
+	if (*p == '0') {
+		++p;
+	}
+	else if (*p >= '1' && *p <= '9') {
+		for (; *p >= '0' && *p <= '9'; ++p) ;
+	}
+	else {
+		return false;
+	}
+	if (*p == '.') {
+		if (*++p < '0' || *p > '9') {
+			return false;
+		}
+		for (; *p >= '0' && *p <= '9'; ++p) ;
+	}
+	if (*p == 'e' || *p == 'E') {
+		++p;
+		p += (*p == '+' || *p == '-') ? 1 : 0;
+		if (*p < '0' || *p > '9') {
+			return false;
+		}
+		for (; *p >= '0' && *p <= '9'; ++p) ;
+	}
+	return *p == '\0';
+}
+
+/*
+* Returns the "frame_id" from a result's JSON, -1 if none. In parallel mode it matches a
+* frame queued with process() to its delivery.
+*/
+static inline int64_t alprJsonFrameId(const char* json)
+{
+	int64_t frameId = -1;
+	if (json && *json) {
+		alprJsonForEachMember(json, [&frameId](const char* key, const char* valueBegin, const char* valueEnd) {
+			if (!strcmp(key, "frame_id")) {
+				AlprJsonCursor c(valueBegin, valueEnd);
+				double value;
+				if (alprJsonReadNumber(c, value)) {
+					frameId = static_cast<int64_t>(value);
+				}
+			}
+		});
+	}
+	return frameId;
+}
+
+#endif /* _ULTIMATE_ALPR_SDK_SAMPLES_JSON_H_ */
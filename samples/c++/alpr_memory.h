@@ -0,0 +1,119 @@
+#if !defined(_ULTIMATE_ALPR_SDK_SAMPLES_MEMORY_H_)
+#define _ULTIMATE_ALPR_SDK_SAMPLES_MEMORY_H_
+
+#include <ultimateALPR-SDK-API-PUBLIC.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#define ALPR_MEMORY_DEFAULT_ALIGNMENT	64 // Cache line and AVX-512 friendly
+
+/*
+* Default aligned allocation: over-allocates and stores the original pointer right before the aligned block
+*/
+static inline void* alprDefaultAlloc(const size_t size, const size_t alignment, void* /*opaque*/)
+{
+	void* raw = malloc(size + alignment + sizeof(void*));
+	if (!raw) {
+		return nullptr;
+	}
+	uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw) + sizeof(void*) + (alignment - 1)) & ~static_cast<uintptr_t>(alignment - 1);
+	reinterpret_cast<void**>(aligned)[-1] = raw;
+	return reinterpret_cast<void*>(aligned);
+}
+
+static inline void alprDefaultFree(void* ptr, void* /*opaque*/)
+{
+	if (ptr) {
+		free(reinterpret_cast<void**>(ptr)[-1]);
+	}
+}
+
+/*
+* Allocator hooks used for the image buffers allocated by the samples helpers (conversions, thumbnails...).
+* Plug your own functions to allocate from hugepages, pinned/DMA memory or a custom heap.
+*/
+struct AlprAllocator {
+	void* (*alloc)(const size_t size, const size_t alignment, void* opaque) = alprDefaultAlloc;
+	void (*free)(void* ptr, void* opaque) = alprDefaultFree;
+	void* opaque = nullptr;
+	size_t alignment = ALPR_MEMORY_DEFAULT_ALIGNMENT; // Must be a power of 2
+
+	inline void* allocate(const size_t size) const { return alloc(size, alignment, opaque); }
+	inline void deallocate(void* ptr) const { free(ptr, opaque); }
+};
+
+/*
+* Thread-safe pool of recycled buffers, keyed by size. Camera streams use a handful of resolutions
+* so after the first frames every acquire() is served from the free lists.
+* Used instead of a per-frame arena: with several frames in flight (AlprAsyncProcessor, parallel mode) there's no point
+* where a whole arena could be reset, each buffer is recycled once its own frame is released.
+* All buffers must be recycled before the pool is destroyed: a buffer still in use may be referenced by a frame
+* in flight, destroying the pool before is a fatal error (abort), in release builds too.
+*/
+class AlprBufferPool {
+public:
+	AlprBufferPool(const AlprAllocator& allocator = AlprAllocator()) : allocator_(allocator) { }
+	virtual ~AlprBufferPool() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (!used_.empty()) {
+			ULTALPR_SDK_PRINT_FATAL("%zu buffer(s) still in use when destroying the pool", used_.size());
+		}
+		ULTALPR_SDK_ASSERT(used_.empty());
+		for (auto& entry : free_) {
+			for (void* ptr : entry.second) {
+				allocator_.deallocate(ptr);
+			}
+		}
+	}
+	AlprBufferPool(const AlprBufferPool&) = delete;
+	AlprBufferPool& operator=(const AlprBufferPool&) = delete;
+
+	void* acquire(const size_t size) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		void* ptr = nullptr;
+		auto it = free_.find(size);
+		if (it != free_.end() && !it->second.empty()) {
+			ptr = it->second.back();
+			it->second.pop_back();
+		}
+		else if ((ptr = allocator_.allocate(size)) == nullptr) {
+			return nullptr;
+		}
+		used_[ptr] = size;
+		return ptr;
+	}
+
+	void recycle(void* ptr) {
+		if (!ptr) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = used_.find(ptr);
+		if (it != used_.end()) {
+			free_[it->second].push_back(ptr);
+			used_.erase(it);
+		}
+	}
+
+	// Frees the buffers not in use
+	void trim() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (auto& entry : free_) {
+			for (void* ptr : entry.second) {
+				allocator_.deallocate(ptr);
+			}
+		}
+		free_.clear();
+	}
+
+private:
+	AlprAllocator allocator_;
+	std::mutex mutex_;
+	std::map<size_t, std::vector<void*> > free_;
+	std::map<void*, size_t> used_;
+};
+
+#endif /* _ULTIMATE_ALPR_SDK_SAMPLES_MEMORY_H_ */
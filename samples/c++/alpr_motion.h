@@ -0,0 +1,211 @@
+#if !defined(_ULTIMATE_ALPR_SDK_SAMPLES_MOTION_H_)
+#define _ULTIMATE_ALPR_SDK_SAMPLES_MOTION_H_
+
+#include <ultimateALPR-SDK-API-PUBLIC.h>
+#include "alpr_utils.h"
+#include "alpr_memory.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+using namespace ultimateAlprSdk;
+
+// Phrase of the results returned without running the engine. Their JSON has an extra "cached": true entry.
+#define ALPR_MOTION_PHRASE_CACHED	"Cached"
+
+#define ALPR_MOTION_CELL_SAMPLES	4 // Each thumbnail cell is the mean of 4x4 samples
+
+struct AlprMotionConfig {
+	float roi[4] = { 0.f, 0.f, 0.f, 0.f }; // [left, right, top, bottom] in pixels (before EXIF rotation), all zeros means full frame
+	int threshold = 12; // Minimum luma difference for a thumbnail cell to be considered changed, within [0, 255]
+	float minChangedRatio = 0.005f; // Minimum ratio of changed cells to trigger the engine, within [0.f, 1.f]
+	size_t maxSkippedFrames = 0; // Run the engine after this many consecutive skipped frames (lighting drift...), zero means never
+	size_t thumbnailWidth = 64; // The height follows the ROI's aspect ratio
+};
+
+/*
+* Motion gating in front of the engine for fixed cameras.
+* Each frame is reduced to a small luma thumbnail (a few hundred samples read from the frame, no copy) and
+* compared with the thumbnail of the last frame sent to the engine. When nothing changed in the ROI, the
+* engine is skipped and the previous result is returned with phrase ALPR_MOTION_PHRASE_CACHED.
+* The engine must be initialized in sequential mode. Not thread-safe: use one gate per camera.
+*/
+class AlprMotionGate {
+public:
+	AlprMotionGate(const AlprMotionConfig& config = AlprMotionConfig(), const AlprAllocator& allocator = AlprAllocator())
+		: config_(config), allocator_(allocator) { }
+	virtual ~AlprMotionGate() {
+		allocator_.deallocate(reference_);
+		allocator_.deallocate(current_);
+	}
+	AlprMotionGate(const AlprMotionGate&) = delete;
+	AlprMotionGate& operator=(const AlprMotionGate&) = delete;
+
+	void setConfig(const AlprMotionConfig& config) {
+		config_ = config;
+		reset();
+	}
+	inline const AlprMotionConfig& config() const { return config_; }
+
+	/*
+	* Forgets the reference thumbnail and the cached result: the next frame always runs the engine
+	*/
+	void reset() {
+		hasReference_ = false;
+		hasResult_ = false;
+		skippedInARow_ = 0;
+	}
+
+	/*
+	* Compares the frame with the reference. The frame becomes the new reference when motion is detected.
+	* @returns true if the frame differs from the reference (or if there's no reference yet), false otherwise.
+	*/
+	bool hasMotion(const AlprFrame& frame) {
+		if (!thumbnail(frame)) {
+			hasReference_ = false;
+			return true; // Unsupported frame: never skip
+		}
+		bool motion = !hasReference_ || (config_.maxSkippedFrames && skippedInARow_ >= config_.maxSkippedFrames);
+		if (!motion) {
+			const size_t count = thumbWidth_ * thumbHeight_;
+			const size_t minChanged = static_cast<size_t>(config_.minChangedRatio * count);
+			size_t changed = 0;
+			for (size_t i = 0; i < count && !motion; ++i) {
+				changed += (abs(static_cast<int>(current_[i]) - static_cast<int>(reference_[i])) > config_.threshold) ? 1 : 0;
+				motion = changed > minChanged;
+			}
+		}
+		if (motion) {
+			uint8_t* tmp = reference_;
+			reference_ = current_;
+			current_ = tmp;
+			hasReference_ = true;
+			skippedInARow_ = 0;
+		}
+		else {
+			++skippedInARow_;
+		}
+		return motion;
+	}
+
+	/*
+	* Runs the engine on the frame only if motion is detected.
+	* @returns the engine's result or a copy of the previous one with phrase ALPR_MOTION_PHRASE_CACHED.
+	*/
+	UltAlprSdkResult process(const AlprFrame& frame) {
+		if (!hasMotion(frame) && hasResult_) {
+			++skipped_;
+			return UltAlprSdkResult(result_.code(), ALPR_MOTION_PHRASE_CACHED, cachedJson_.c_str(), result_.numPlates(), result_.numCars());
+		}
+		UltAlprSdkResult result = alprProcessFrame(frame);
+		hasResult_ = result.isOK();
+		if (hasResult_) {
+			result_ = result;
+			const char* json = result.json();
+			cachedJson_ = (json && json[0] == '{' && json[1] != '}')
+				? (std::string("{\"cached\":true,") + (json + 1))
+				: std::string("{\"cached\":true}");
+		}
+		else {
+			hasReference_ = false; // Retry on the next frame
+		}
+		return result;
+	}
+
+	/*
+	* Number of frames for which the engine was skipped
+	*/
+	inline uint64_t skipped() const { return skipped_; }
+
+private:
+	// Luma sample, approximated as (R + 2G + B) / 4 for the RGB-family formats
+	static inline int luma(const uint8_t* row, const size_t x, const size_t bytesPerSample) {
+		if (bytesPerSample < 3) {
+			return row[x];
+		}
+		const uint8_t* p = row + (x * bytesPerSample);
+		return (p[0] + (p[1] << 1) + p[2]) >> 2;
+	}
+
+	// Computes the thumbnail of the frame's ROI into "current_"
+	bool thumbnail(const AlprFrame& frame) {
+		if (!frame.data[0] || !frame.width || !frame.height) {
+			return false;
+		}
+		size_t bytesPerSample = alprBytesPerSample(frame.type);
+		if (frame.isPlanar() || !bytesPerSample) {
+			bytesPerSample = 1; // Planar or contiguous YUV-family: 8-bit luma plane first
+		}
+		// Stride in samples, 0 meaning tightly packed (same as the engine)
+		const size_t stride = (frame.strides[0] ? frame.strides[0] : frame.width) * bytesPerSample;
+		size_t left = 0, right = frame.width, top = 0, bottom = frame.height;
+		if (config_.roi[0] || config_.roi[1] || config_.roi[2] || config_.roi[3]) {
+			left = static_cast<size_t>(config_.roi[0] < 0.f ? 0.f : config_.roi[0]);
+			right = static_cast<size_t>(config_.roi[1] < 0.f ? 0.f : config_.roi[1]);
+			top = static_cast<size_t>(config_.roi[2] < 0.f ? 0.f : config_.roi[2]);
+			bottom = static_cast<size_t>(config_.roi[3] < 0.f ? 0.f : config_.roi[3]);
+			right = right > frame.width ? frame.width : right;
+			bottom = bottom > frame.height ? frame.height : bottom;
+			if (left >= right || top >= bottom) {
+				return false;
+			}
+		}
+		const size_t roiWidth = right - left, roiHeight = bottom - top;
+		size_t thumbWidth = config_.thumbnailWidth ? config_.thumbnailWidth : 64;
+		thumbWidth = thumbWidth > roiWidth ? roiWidth : thumbWidth;
+		size_t thumbHeight = (thumbWidth * roiHeight) / roiWidth;
+		thumbHeight = thumbHeight ? (thumbHeight > roiHeight ? roiHeight : thumbHeight) : 1;
+
+		// (Re)allocate on resolution or ROI change, the reference becomes meaningless
+		if (thumbWidth != thumbWidth_ || thumbHeight != thumbHeight_ || frame.width != frameWidth_ || frame.height != frameHeight_) {
+			allocator_.deallocate(reference_);
+			allocator_.deallocate(current_);
+			reference_ = static_cast<uint8_t*>(allocator_.allocate(thumbWidth * thumbHeight));
+			current_ = static_cast<uint8_t*>(allocator_.allocate(thumbWidth * thumbHeight));
+			if (!reference_ || !current_) {
+				thumbWidth_ = thumbHeight_ = 0;
+				return false;
+			}
+			thumbWidth_ = thumbWidth;
+			thumbHeight_ = thumbHeight;
+			frameWidth_ = frame.width;
+			frameHeight_ = frame.height;
+			hasReference_ = false;
+		}
+
+		const uint8_t* base = static_cast<const uint8_t*>(frame.data[0]);
+		for (size_t ty = 0; ty < thumbHeight; ++ty) {
+			const size_t y0 = top + (ty * roiHeight) / thumbHeight;
+			const size_t cellHeight = top + ((ty + 1) * roiHeight) / thumbHeight - y0;
+			for (size_t tx = 0; tx < thumbWidth; ++tx) {
+				const size_t x0 = left + (tx * roiWidth) / thumbWidth;
+				const size_t cellWidth = left + ((tx + 1) * roiWidth) / thumbWidth - x0;
+				int sum = 0;
+				for (size_t sy = 0; sy < ALPR_MOTION_CELL_SAMPLES; ++sy) {
+					const uint8_t* row = base + (y0 + (sy * cellHeight) / ALPR_MOTION_CELL_SAMPLES) * stride;
+					for (size_t sx = 0; sx < ALPR_MOTION_CELL_SAMPLES; ++sx) {
+						sum += luma(row, x0 + (sx * cellWidth) / ALPR_MOTION_CELL_SAMPLES, bytesPerSample);
+					}
+				}
+				current_[(ty * thumbWidth) + tx] = static_cast<uint8_t>(sum / (ALPR_MOTION_CELL_SAMPLES * ALPR_MOTION_CELL_SAMPLES));
+			}
+		}
+		return true;
+	}
+
+	AlprMotionConfig config_;
+	AlprAllocator allocator_;
+	uint8_t* reference_ = nullptr;
+	uint8_t* current_ = nullptr;
+	size_t thumbWidth_ = 0, thumbHeight_ = 0;
+	size_t frameWidth_ = 0, frameHeight_ = 0;
+	bool hasReference_ = false;
+	bool hasResult_ = false;
+	size_t skippedInARow_ = 0;
+	uint64_t skipped_ = 0;
+	UltAlprSdkResult result_;
+	std::string cachedJson_;
+};
+
+#endif /* _ULTIMATE_ALPR_SDK_SAMPLES_MOTION_H_ */
@@ -0,0 +1,493 @@
+#if !defined(_ULTIMATE_ALPR_SDK_SAMPLES_PLATES_H_)
+#define _ULTIMATE_ALPR_SDK_SAMPLES_PLATES_H_
+
+#include <ultimateALPR-SDK-API-PUBLIC.h>
+#include "alpr_json.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace ultimateAlprSdk;
+
+#define ALPR_PLATE_TEXT_MAX_SIZE		64 // UTF-8 bytes, including the null terminator
+#define ALPR_PLATE_CONFIDENCES_MAX_COUNT	34 // recognition, detection then up to 32 characters
+#define ALPR_KLASS_NAME_MAX_SIZE		48
+
+/*
+* Top-1 output of a classifier (LPCI, VCR, VMMR or VBSR)
+*/
+struct AlprKlass {
+	int klass = -1; // -1 when the classifier is disabled or didn't return anything
+	float confidence = 0.f;
+	char name[ALPR_KLASS_NAME_MAX_SIZE] = { 0 };
+};
+
+/*
+* Description of a license plate (and its car). Fixed-size members only (no heap allocation), copyable with
+* plain assignment.
+* More info about the JSON fields: https://www.doubango.org/SDKs/anpr/docs/Data_structures.html
+*/
+struct AlprPlate {
+	char text[ALPR_PLATE_TEXT_MAX_SIZE] = { 0 };
+	float warpedBox[8] = { 0.f };
+	// confidences[0] = recognition score, confidences[1] = detection score, [2...] = per-character scores
+	float confidences[ALPR_PLATE_CONFIDENCES_MAX_COUNT] = { 0.f };
+	size_t numConfidences = 0;
+	bool hasCar = false;
+	float carWarpedBox[8] = { 0.f };
+	float carConfidence = 0.f;
+	AlprKlass country; // LPCI
+	AlprKlass color; // VCR
+	AlprKlass makeModelYear; // VMMR
+	AlprKlass bodyStyle; // VBSR
+
+	inline float recognitionConfidence() const { return numConfidences > 0 ? confidences[0] : 0.f; }
+	inline float detectionConfidence() const { return numConfidences > 1 ? confidences[1] : 0.f; }
+	inline size_t numCharacterConfidences() const { return numConfidences > 2 ? (numConfidences - 2) : 0; }
+	inline const float* characterConfidences() const { return &confidences[2]; }
+};
+
+/*
+* Plates extracted from a result
+*/
+struct AlprPlates {
+	int64_t frameId = -1;
+	double durationMillis = -1.0; // Engine-reported processing time, -1 if not present
+	std::vector<AlprPlate> plates;
+
+	inline size_t size() const { return plates.size(); }
+	inline bool empty() const { return plates.empty(); }
+	inline const AlprPlate* data() const { return plates.data(); }
+	inline const AlprPlate* begin() const { return plates.data(); }
+	inline const AlprPlate* end() const { return plates.data() + plates.size(); }
+	inline const AlprPlate& operator[](const size_t index) const { return plates[index]; }
+};
+
+// Reads a list of classifier outputs and keeps the one with the highest confidence
+static inline bool alprJsonReadKlasses(AlprJsonCursor& c, AlprKlass& top)
+{
+	char key[32];
+	if (!c.expect('[')) {
+		return false;
+	}
+	if (c.consume(']')) {
+		return true;
+	}
+	do {
+		AlprKlass k;
+		char make[ALPR_KLASS_NAME_MAX_SIZE] = { 0 }, model[ALPR_KLASS_NAME_MAX_SIZE] = { 0 };
+		if (!c.expect('{')) {
+			return false;
+		}
+		if (!c.consume('}')) {
+			do {
+				double value;
+				if (!alprJsonReadKey(c, key, sizeof(key))) {
+					return false;
+				}
+				if (!strcmp(key, "klass")) {
+					if (!alprJsonReadNumber(c, value)) return false;
+					k.klass = static_cast<int>(value);
+				}
+				else if (!strcmp(key, "confidence")) {
+					if (!alprJsonReadNumber(c, value)) return false;
+					k.confidence = static_cast<float>(value);
+				}
+				else if (!strcmp(key, "name") && c.peek('"')) {
+					if (!alprJsonReadString(c, k.name, sizeof(k.name))) return false;
+				}
+				else if (!strcmp(key, "make") && c.peek('"')) {
+					if (!alprJsonReadString(c, make, sizeof(make))) return false;
+				}
+				else if (!strcmp(key, "model") && c.peek('"')) {
+					if (!alprJsonReadString(c, model, sizeof(model))) return false;
+				}
+				else if (!alprJsonSkipValue(c)) {
+					return false;
+				}
+			} while (c.consume(','));
+			if (!c.expect('}')) {
+				return false;
+			}
+		}
+		if (!k.name[0] && make[0]) { // VMMR has no "name" field
+			snprintf(k.name, sizeof(k.name), "%.23s %.23s", make, model);
+		}
+		if (top.klass < 0 || k.confidence > top.confidence) {
+			top = k;
+		}
+	} while (c.consume(','));
+	return c.expect(']');
+}
+
+static inline bool alprJsonReadCar(AlprJsonCursor& c, AlprPlate& plate)
+{
+	char key[32];
+	size_t count;
+	double value;
+	if (!c.expect('{')) {
+		return false;
+	}
+	plate.hasCar = true;
+	if (c.consume('}')) {
+		return true;
+	}
+	do {
+		if (!alprJsonReadKey(c, key, sizeof(key))) {
+			return false;
+		}
+		bool ok;
+		if (!strcmp(key, "warpedBox")) ok = alprJsonReadFloats(c, plate.carWarpedBox, 8, count);
+		else if (!strcmp(key, "confidence")) { ok = alprJsonReadNumber(c, value); plate.carConfidence = static_cast<float>(value); }
+		else if (!strcmp(key, "color")) ok = alprJsonReadKlasses(c, plate.color);
+		else if (!strcmp(key, "makeModelYear")) ok = alprJsonReadKlasses(c, plate.makeModelYear);
+		else if (!strcmp(key, "bodyStyle")) ok = alprJsonReadKlasses(c, plate.bodyStyle);
+		else ok = alprJsonSkipValue(c);
+		if (!ok) {
+			return false;
+		}
+	} while (c.consume(','));
+	return c.expect('}');
+}
+
+static inline bool alprJsonReadPlate(AlprJsonCursor& c, AlprPlate& plate)
+{
+	char key[32];
+	size_t count;
+	if (!c.expect('{')) {
+		return false;
+	}
+	if (c.consume('}')) {
+		return true;
+	}
+	do {
+		if (!alprJsonReadKey(c, key, sizeof(key))) {
+			return false;
+		}
+		bool ok;
+		if (!strcmp(key, "text")) ok = alprJsonReadString(c, plate.text, sizeof(plate.text));
+		else if (!strcmp(key, "warpedBox")) ok = alprJsonReadFloats(c, plate.warpedBox, 8, count);
+		else if (!strcmp(key, "confidences")) ok = alprJsonReadFloats(c, plate.confidences, ALPR_PLATE_CONFIDENCES_MAX_COUNT, plate.numConfidences);
+		else if (!strcmp(key, "car")) ok = alprJsonReadCar(c, plate);
+		else if (!strcmp(key, "country")) ok = alprJsonReadKlasses(c, plate.country);
+		else ok = alprJsonSkipValue(c);
+		if (!ok) {
+			return false;
+		}
+	} while (c.consume(','));
+	return c.expect('}');
+}
+
+/*
+* Extracts the plates from the JSON string returned by the engine, without building a DOM.
+* The "plates" vector is reused across calls to avoid allocations: pass the same object for each frame.
+* @param json JSON string from UltAlprSdkResult::json(). May be null or empty.
+* @param plates Extracted plates.
+* @returns true if the JSON was successfully parsed, false otherwise.
+*/
+static inline bool alprParsePlates(const char* json, AlprPlates& plates)
+{
+	char key[32];
+	plates.frameId = -1;
+	plates.durationMillis = -1.0;
+	plates.plates.clear();
+	if (!json || !*json) {
+		return true;
+	}
+	AlprJsonCursor c(json);
+	if (!c.expect('{')) {
+		return false;
+	}
+	if (c.consume('}')) {
+		return true;
+	}
+	do {
+		if (!alprJsonReadKey(c, key, sizeof(key))) {
+			return false;
+		}
+		if (!strcmp(key, "frame_id")) {
+			double value;
+			if (!alprJsonReadNumber(c, value)) {
+				return false;
+			}
+			plates.frameId = static_cast<int64_t>(value);
+		}
+		else if (!strcmp(key, "duration")) {
+			if (!alprJsonReadNumber(c, plates.durationMillis)) {
+				return false;
+			}
+		}
+		else if (!strcmp(key, "plates")) {
+			if (!c.expect('[')) {
+				return false;
+			}
+			if (!c.consume(']')) {
+				do {
+					plates.plates.emplace_back();
+					if (!alprJsonReadPlate(c, plates.plates.back())) {
+						return false;
+					}
+				} while (c.consume(','));
+				if (!c.expect(']')) {
+					return false;
+				}
+			}
+		}
+		else if (!alprJsonSkipValue(c)) {
+			return false;
+		}
+	} while (c.consume(','));
+	return c.expect('}');
+}
+
+/*
+* Same as above but directly from the result. The JSON is parsed even without plate or car:
+* "frame_id" and "duration" are always set.
+*/
+static inline bool alprParsePlates(const UltAlprSdkResult& result, AlprPlates& plates)
+{
+	return alprParsePlates(result.json(), plates);
+}
+
+/*
+* Fields written by alprSerializePlates()
+*/
+enum AlprResultField {
+	ALPR_RESULT_FIELD_TEXT = (1 << 0), // "text"
+	ALPR_RESULT_FIELD_WARPED_BOX = (1 << 1), // "warpedBox"
+	ALPR_RESULT_FIELD_CONFIDENCES = (1 << 2), // "confidences": recognition and detection scores
+	ALPR_RESULT_FIELD_CHAR_CONFIDENCES = (1 << 3), // "confidences": per-character scores, implies ALPR_RESULT_FIELD_CONFIDENCES
+	ALPR_RESULT_FIELD_CAR = (1 << 4), // "car": box and confidence
+	ALPR_RESULT_FIELD_KLASSES = (1 << 5), // "country", "car.color", "car.makeModelYear", "car.bodyStyle"
+	ALPR_RESULT_FIELD_TIMINGS = (1 << 6), // "frame_id", "duration"
+	ALPR_RESULT_FIELD_ALL = 0x7f
+};
+
+/*
+* Result schema: which fields to serialize and how many decimals to keep.
+* Config entries (JSON): "result_fields": ["text", "warpedBox", "confidences", "char_confidences", "car", "klass", "timings"]
+* and "result_precision": <number of decimals, -1 for full precision>.
+*/
+struct AlprResultSchema {
+	uint32_t fields = ALPR_RESULT_FIELD_ALL;
+	int precision = -1;
+
+	static bool isSchemaKey(const char* key) {
+		return !strcmp(key, "result_fields") || !strcmp(key, "result_precision");
+	}
+
+	// Updates the schema entry "key" using the raw JSON "value". Returns false if the value is invalid.
+	bool set(const char* key, const char* valueBegin, const char* valueEnd) {
+		AlprJsonCursor c(valueBegin, valueEnd);
+		if (!strcmp(key, "result_precision")) {
+			double value;
+			if (!alprJsonReadNumber(c, value) || value < -1.0 || value > 9.0) {
+				return false;
+			}
+			precision = static_cast<int>(value);
+			return true;
+		}
+		static const struct { const char* name; uint32_t field; } names[] = {
+			{ "text", ALPR_RESULT_FIELD_TEXT }, { "warpedBox", ALPR_RESULT_FIELD_WARPED_BOX },
+			{ "confidences", ALPR_RESULT_FIELD_CONFIDENCES }, { "char_confidences", ALPR_RESULT_FIELD_CHAR_CONFIDENCES },
+			{ "car", ALPR_RESULT_FIELD_CAR }, { "klass", ALPR_RESULT_FIELD_KLASSES }, { "timings", ALPR_RESULT_FIELD_TIMINGS },
+		};
+		char name[32];
+		uint32_t mask = 0;
+		if (!c.expect('[')) {
+			return false;
+		}
+		if (!c.consume(']')) {
+			do {
+				if (!alprJsonReadString(c, name, sizeof(name))) {
+					return false;
+				}
+				size_t i = 0;
+				for (; i < sizeof(names) / sizeof(names[0]) && strcmp(names[i].name, name); ++i) ;
+				if (i == sizeof(names) / sizeof(names[0])) {
+					ULTALPR_SDK_PRINT_ERROR("Unknown result field: %s", name);
+					return false;
+				}
+				mask |= names[i].field;
+			} while (c.consume(','));
+			if (!c.expect(']')) {
+				return false;
+			}
+		}
+		fields = mask;
+		return true;
+	}
+
+	// Reads the schema entries from a JSON config. Other entries are ignored.
+	bool parse(const char* json) {
+		bool ok = true;
+		ok &= alprJsonForEachMember(json, [&](const char* key, const char* valueBegin, const char* valueEnd) {
+			if (isSchemaKey(key)) {
+				ok &= set(key, valueBegin, valueEnd);
+			}
+		});
+		return ok;
+	}
+};
+
+// Appends a number using the schema's precision, trailing zeros removed ("12.50" -> "12.5", "3.00" -> "3")
+static inline void alprJsonWriteNumber(std::string& out, const double value, const int precision)
+{
+	char buffer[32];
+	int len = (precision < 0)
+		? snprintf(buffer, sizeof(buffer), "%.7g", value)
+		: snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+	if (precision > 0) {
+		while (len > 1 && buffer[len - 1] == '0') {
+			--len;
+		}
+		if (buffer[len - 1] == '.') {
+			--len;
+		}
+	}
+	if (len == 2 && buffer[0] == '-' && buffer[1] == '0') { // "-0"
+		buffer[0] = '0';
+		len = 1;
+	}
+	out.append(buffer, static_cast<size_t>(len));
+}
+
+// Appends "key": preceded by a comma unless it's the first member of the object
+static inline void alprJsonWriteKey(std::string& out, bool& first, const char* key)
+{
+	if (!first) {
+		out += ',';
+	}
+	first = false;
+	out += '"';
+	out += key;
+	out += "\":";
+}
+
+static inline void alprJsonWriteString(std::string& out, const char* value)
+{
+	out += '"';
+	for (; *value; ++value) {
+		const unsigned char c = static_cast<unsigned char>(*value);
+		switch (c) {
+		case '"': out += "\\\""; break;
+		case '\\': out += "\\\\"; break;
+		case '\n': out += "\\n"; break;
+		case '\t': out += "\\t"; break;
+		case '\r': out += "\\r"; break;
+		case '\b': out += "\\b"; break;
+		case '\f': out += "\\f"; break;
+		default:
+			if (c < 0x20) { // Other control characters aren't allowed in JSON strings either
+				char escaped[8];
+				snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+				out += escaped;
+			}
+			else {
+				out += *value;
+			}
+			break;
+		}
+	}
+	out += '"';
+}
+
+static inline void alprJsonWriteNumbers(std::string& out, bool& first, const char* key, const float* values, const size_t count, const int precision)
+{
+	alprJsonWriteKey(out, first, key);
+	out += '[';
+	for (size_t i = 0; i < count; ++i) {
+		if (i) {
+			out += ',';
+		}
+		alprJsonWriteNumber(out, values[i], precision);
+	}
+	out += ']';
+}
+
+static inline void alprJsonWriteKlass(std::string& out, bool& first, const char* key, const AlprKlass& klass, const int precision)
+{
+	if (klass.klass < 0) {
+		return;
+	}
+	alprJsonWriteKey(out, first, key);
+	out += "[{\"klass\":";
+	alprJsonWriteNumber(out, klass.klass, 0);
+	out += ",\"confidence\":";
+	alprJsonWriteNumber(out, klass.confidence, precision);
+	out += ",\"name\":";
+	alprJsonWriteString(out, klass.name);
+	out += "}]";
+}
+
+/*
+* Serializes the plates with only the fields selected by the schema. Same field names as the engine's JSON
+* (readable with alprParsePlates) but classifiers are reduced to their top-1 output. Meant for the transport
+* of the results when most consumers only need the text and the box.
+* @param plates Plates to serialize.
+* @param schema Fields and precision.
+* @param out Output JSON. Cleared first, reuse the same string across frames to avoid allocations.
+*/
+static inline void alprSerializePlates(const AlprPlates& plates, const AlprResultSchema& schema, std::string& out)
+{
+	const uint32_t fields = schema.fields;
+	const int precision = schema.precision;
+	bool first = true;
+	out.clear();
+	out += '{';
+	if ((fields & ALPR_RESULT_FIELD_TIMINGS) && plates.frameId >= 0) {
+		alprJsonWriteKey(out, first, "frame_id");
+		alprJsonWriteNumber(out, static_cast<double>(plates.frameId), 0);
+	}
+	if ((fields & ALPR_RESULT_FIELD_TIMINGS) && plates.durationMillis >= 0.0) {
+		alprJsonWriteKey(out, first, "duration");
+		alprJsonWriteNumber(out, plates.durationMillis, precision);
+	}
+	if (!plates.empty()) {
+		alprJsonWriteKey(out, first, "plates");
+		out += '[';
+		for (size_t i = 0; i < plates.size(); ++i) {
+			const AlprPlate& plate = plates[i];
+			bool firstField = true;
+			out += i ? ",{" : "{";
+			if (fields & ALPR_RESULT_FIELD_TEXT) {
+				alprJsonWriteKey(out, firstField, "text");
+				alprJsonWriteString(out, plate.text);
+			}
+			if (fields & ALPR_RESULT_FIELD_WARPED_BOX) {
+				alprJsonWriteNumbers(out, firstField, "warpedBox", plate.warpedBox, 8, precision);
+			}
+			if (fields & (ALPR_RESULT_FIELD_CONFIDENCES | ALPR_RESULT_FIELD_CHAR_CONFIDENCES)) {
+				const size_t count = (fields & ALPR_RESULT_FIELD_CHAR_CONFIDENCES) ? plate.numConfidences
+					: (plate.numConfidences < 2 ? plate.numConfidences : 2);
+				alprJsonWriteNumbers(out, firstField, "confidences", plate.confidences, count, precision);
+			}
+			if (fields & ALPR_RESULT_FIELD_KLASSES) {
+				alprJsonWriteKlass(out, firstField, "country", plate.country, precision);
+			}
+			if ((fields & (ALPR_RESULT_FIELD_CAR | ALPR_RESULT_FIELD_KLASSES)) && plate.hasCar) {
+				bool firstCarField = true;
+				alprJsonWriteKey(out, firstField, "car");
+				out += '{';
+				if (fields & ALPR_RESULT_FIELD_CAR) {
+					alprJsonWriteNumbers(out, firstCarField, "warpedBox", plate.carWarpedBox, 8, precision);
+					alprJsonWriteKey(out, firstCarField, "confidence");
+					alprJsonWriteNumber(out, plate.carConfidence, precision);
+				}
+				if (fields & ALPR_RESULT_FIELD_KLASSES) {
+					alprJsonWriteKlass(out, firstCarField, "color", plate.color, precision);
+					alprJsonWriteKlass(out, firstCarField, "makeModelYear", plate.makeModelYear, precision);
+					alprJsonWriteKlass(out, firstCarField, "bodyStyle", plate.bodyStyle, precision);
+				}
+				out += '}';
+			}
+			out += '}';
+		}
+		out += ']';
+	}
+	out += '}';
+}
+
+#endif /* _ULTIMATE_ALPR_SDK_SAMPLES_PLATES_H_ */
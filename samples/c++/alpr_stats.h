@@ -0,0 +1,286 @@
+#if !defined(_ULTIMATE_ALPR_SDK_SAMPLES_STATS_H_)
+#define _ULTIMATE_ALPR_SDK_SAMPLES_STATS_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#if defined(_WIN32)
+#	if !defined(NOMINMAX)
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#	include <psapi.h>
+#	if defined(_MSC_VER)
+#		pragma comment(lib, "psapi.lib")
+#	endif
+#elif defined(__APPLE__)
+#	include <mach/mach.h>
+#	include <sys/sysctl.h>
+#endif
+
+#define ALPR_HISTOGRAM_BUCKET_COUNT	64 // Bucket i covers [2^(i/2), 2^((i+1)/2)) microseconds: 2^32 microseconds (~1.2 hours) max
+
+/*
+* Latency histogram with fixed half-octave buckets. No allocation, percentiles are approximated
+* with the upper bound of the bucket (within ~41%) and clamped to the exact min/max.
+* Samples above the last bound are counted in "overflow" (and in the last bucket): their percentiles are clamped to the max.
+*/
+struct AlprLatencyHistogram {
+	uint64_t buckets[ALPR_HISTOGRAM_BUCKET_COUNT] = { 0 };
+	uint64_t count = 0;
+	uint64_t overflow = 0;
+	double sumMicros = 0.0;
+	double minMicros = 0.0;
+	double maxMicros = 0.0;
+
+	void add(const double micros) {
+		size_t index = 0;
+		while (index < (ALPR_HISTOGRAM_BUCKET_COUNT - 1) && micros >= upperBound(index)) {
+			++index;
+		}
+		++buckets[index];
+		overflow += (micros >= upperBound(ALPR_HISTOGRAM_BUCKET_COUNT - 1)) ? 1 : 0;
+		minMicros = (count == 0 || micros < minMicros) ? micros : minMicros;
+		maxMicros = (count == 0 || micros > maxMicros) ? micros : maxMicros;
+		sumMicros += micros;
+		++count;
+	}
+	double meanMicros() const {
+		return count ? (sumMicros / count) : 0.0;
+	}
+	// "p" within [0.0, 1.0]
+	double percentileMicros(const double p) const {
+		if (!count) {
+			return 0.0;
+		}
+		const uint64_t rank = static_cast<uint64_t>(p * (count - 1)) + 1;
+		uint64_t seen = 0;
+		for (size_t i = 0; i < ALPR_HISTOGRAM_BUCKET_COUNT; ++i) {
+			if ((seen += buckets[i]) >= rank) {
+				const double bound = upperBound(i);
+				return bound < minMicros ? minMicros : (bound > maxMicros ? maxMicros : bound);
+			}
+		}
+		return maxMicros;
+	}
+	void reset() {
+		*this = AlprLatencyHistogram();
+	}
+	static constexpr double upperBound(const size_t index) {
+		return static_cast<double>(1ull << ((index + 1) >> 1)) * (((index + 1) & 1) ? 1.41421356 : 1.0);
+	}
+};
+static_assert(AlprLatencyHistogram::upperBound(ALPR_HISTOGRAM_BUCKET_COUNT - 1) >= 3600.0 * 1000000.0, "The histogram must cover at least one hour");
+
+/*
+* Memory used by the current process, in bytes. The models are loaded by the engine into the process' heap,
+* use this to measure the cost of each klass_*_enabled option (e.g. before and after init) on small devices.
+* @param residentBytes Resident set size.
+* @param peakResidentBytes Peak resident set size since the process started.
+* @returns true if succeeded, false if not supported on this platform.
+*/
+static inline bool alprMemoryUsage(size_t& residentBytes, size_t& peakResidentBytes)
+{
+	residentBytes = peakResidentBytes = 0;
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return false;
+	}
+	residentBytes = counters.WorkingSetSize;
+	peakResidentBytes = counters.PeakWorkingSetSize;
+	return true;
+#elif defined(__APPLE__)
+	mach_task_basic_info_data_t info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+		return false;
+	}
+	residentBytes = static_cast<size_t>(info.resident_size);
+	peakResidentBytes = static_cast<size_t>(info.resident_size_max);
+	return true;
+#elif defined(__linux__)
+	FILE* file = fopen("/proc/self/status", "r");
+	if (!file) {
+		return false;
+	}
+	char line[128];
+	unsigned long long kb;
+	while (fgets(line, sizeof(line), file)) {
+		if (sscanf(line, "VmRSS: %llu kB", &kb) == 1) {
+			residentBytes = static_cast<size_t>(kb << 10);
+		}
+		else if (sscanf(line, "VmHWM: %llu kB", &kb) == 1) {
+			peakResidentBytes = static_cast<size_t>(kb << 10);
+		}
+	}
+	fclose(file);
+	return residentBytes != 0;
+#else
+	return false;
+#endif
+}
+
+/*
+* Human-readable CPU name (e.g. "Intel(R) Core(TM) i7-4790K CPU @ 4.00GHz"), used to label the benchmark reports.
+* Falls back to the board name on ARM Linux devices without "model name" (e.g. "Raspberry Pi 4 Model B Rev 1.4").
+* @returns the name or an empty string if not available on this platform.
+*/
+static inline std::string alprCpuName()
+{
+	std::string name;
+#if defined(_WIN32)
+	const char* identifier = getenv("PROCESSOR_IDENTIFIER");
+	name = identifier ? identifier : "";
+#elif defined(__APPLE__)
+	char buffer[256];
+	size_t size = sizeof(buffer);
+	if (sysctlbyname("machdep.cpu.brand_string", buffer, &size, nullptr, 0) == 0) {
+		name.assign(buffer, strnlen(buffer, sizeof(buffer)));
+	}
+#elif defined(__linux__)
+	FILE* file = fopen("/proc/cpuinfo", "r");
+	if (!file) {
+		return name;
+	}
+	char line[256];
+	std::string board;
+	while (fgets(line, sizeof(line), file) && name.empty()) {
+		const char* colon = strchr(line, ':');
+		if (!colon) {
+			continue;
+		}
+		std::string value(colon + 1);
+		value.erase(0, value.find_first_not_of(" \t"));
+		value.erase(value.find_last_not_of(" \t\r\n") + 1);
+		if (!strncmp(line, "model name", 10)) {
+			name = value;
+		}
+		else if (!strncmp(line, "Model", 5) || !strncmp(line, "Hardware", 8)) {
+			board = value;
+		}
+	}
+	fclose(file);
+	if (name.empty()) {
+		name = board;
+	}
+#endif
+	return name;
+}
+
+/*
+* Statistics shared by the samples helpers (engine instances, asynchronous processor...).
+* Thread-safe. The engine's internal stages (detection, pyramidal search, recognition, classifiers)
+* are not exposed by the SDK: "engine" is the engine-reported "duration" when present in the result JSON.
+*/
+class AlprStats {
+public:
+	enum Stage {
+		ALPR_STATS_STAGE_QUEUE_WAIT, // Time spent in the asynchronous processor's queue
+		ALPR_STATS_STAGE_PROCESS, // UltAlprSdkEngine::process() as seen by the caller
+		ALPR_STATS_STAGE_ENGINE, // Engine-reported "duration"
+		ALPR_STATS_STAGE_PARSE, // Result JSON to plate records
+		ALPR_STATS_STAGE_COUNT
+	};
+
+	AlprStats() : start_(std::chrono::steady_clock::now()) { }
+
+	void addLatency(const Stage stage, const double micros) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		stages_[stage].add(micros);
+	}
+	void addFrame(const bool ok, const size_t numPlates, const size_t numCars) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		++frames_;
+		errors_ += ok ? 0 : 1;
+		framesWithPlates_ += numPlates ? 1 : 0;
+		plates_ += numPlates;
+		cars_ += numCars;
+	}
+	void addDropped(const uint64_t count = 1) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		dropped_ += count;
+	}
+	void setQueueDepth(const size_t depth) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		queueDepth_ = depth;
+		queueDepthMax_ = depth > queueDepthMax_ ? depth : queueDepthMax_;
+	}
+
+	/*
+	* Number of dropped frames since creation or last reset
+	*/
+	uint64_t dropped() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return dropped_;
+	}
+
+	/*
+	* Snapshot of the statistics since creation or last reset, as JSON. Latencies are in milliseconds.
+	* The process' current memory usage is included when supported (see alprMemoryUsage).
+	*/
+	std::string json() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		static const char* names[ALPR_STATS_STAGE_COUNT] = { "queue_wait", "process", "engine", "parse" };
+		const double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+		char buffer[512];
+		snprintf(buffer, sizeof(buffer),
+			"{\"elapsed_sec\":%.3f,\"frames\":%llu,\"fps\":%.2f,\"errors\":%llu,\"frames_with_plates\":%llu,\"plates\":%llu,\"cars\":%llu,"
+			"\"dropped\":%llu,\"queue_depth\":%zu,\"queue_depth_max\":%zu,\"stages\":{",
+			elapsedSec, (unsigned long long)frames_, elapsedSec > 0.0 ? (frames_ / elapsedSec) : 0.0, (unsigned long long)errors_,
+			(unsigned long long)framesWithPlates_, (unsigned long long)plates_, (unsigned long long)cars_,
+			(unsigned long long)dropped_, queueDepth_, queueDepthMax_
+		);
+		std::string json = buffer;
+		for (size_t i = 0; i < ALPR_STATS_STAGE_COUNT; ++i) {
+			const AlprLatencyHistogram& h = stages_[i];
+			snprintf(buffer, sizeof(buffer),
+				"%s\"%s\":{\"count\":%llu,\"mean\":%.3f,\"min\":%.3f,\"p50\":%.3f,\"p90\":%.3f,\"p99\":%.3f,\"max\":%.3f,\"overflow\":%llu}",
+				i ? "," : "", names[i], (unsigned long long)h.count, h.meanMicros() / 1000.0, h.minMicros / 1000.0,
+				h.percentileMicros(0.50) / 1000.0, h.percentileMicros(0.90) / 1000.0, h.percentileMicros(0.99) / 1000.0, h.maxMicros / 1000.0,
+				(unsigned long long)h.overflow
+			);
+			json += buffer;
+		}
+		size_t residentBytes, peakResidentBytes;
+		if (alprMemoryUsage(residentBytes, peakResidentBytes)) {
+			snprintf(buffer, sizeof(buffer), "},\"memory\":{\"resident_mb\":%.1f,\"peak_resident_mb\":%.1f}}",
+				residentBytes / 1048576.0, peakResidentBytes / 1048576.0);
+			return json + buffer;
+		}
+		return json + "}}";
+	}
+
+	void reset() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (size_t i = 0; i < ALPR_STATS_STAGE_COUNT; ++i) {
+			stages_[i].reset();
+		}
+		frames_ = errors_ = framesWithPlates_ = plates_ = cars_ = dropped_ = 0;
+		queueDepthMax_ = queueDepth_;
+		start_ = std::chrono::steady_clock::now();
+	}
+
+private:
+	std::mutex mutex_;
+	AlprLatencyHistogram stages_[ALPR_STATS_STAGE_COUNT];
+	uint64_t frames_ = 0, errors_ = 0, framesWithPlates_ = 0, plates_ = 0, cars_ = 0, dropped_ = 0;
+	size_t queueDepth_ = 0, queueDepthMax_ = 0;
+	std::chrono::steady_clock::time_point start_;
+};
+
+/*
+* Measures the time elapsed since creation, in microseconds
+*/
+struct AlprStopwatch {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	inline double micros() const {
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+	}
+};
+
+#endif /* _ULTIMATE_ALPR_SDK_SAMPLES_STATS_H_ */
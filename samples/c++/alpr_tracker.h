@@ -0,0 +1,203 @@
+#if !defined(_ULTIMATE_ALPR_SDK_SAMPLES_TRACKER_H_)
+#define _ULTIMATE_ALPR_SDK_SAMPLES_TRACKER_H_
+
+#include "alpr_plates.h"
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#define ALPR_TRACK_MAX_CANDIDATES	4 // Distinct texts voted per track
+
+struct AlprTrackerConfig {
+	float minIou = 0.3f; // Minimum overlap between a detection and the track's last box, within [0.f, 1.f]
+	float confirmConfidence = 90.f; // Minimum recognition confidence (percent, as in the result JSON) for a read to count as a vote
+	size_t confirmHits = 3; // Number of identical votes required to confirm the text
+	size_t maxMisses = 15; // Frames without detection before the track is dropped
+};
+
+/*
+* Plate (and car) followed across frames
+*/
+struct AlprTrack {
+	uint64_t id = 0; // Stable, never reused
+	AlprPlate plate; // Latest detection (boxes, classifiers). Its "text" is the latest read, see "text" for the track's text.
+	char text[ALPR_PLATE_TEXT_MAX_SIZE] = { 0 }; // Confirmed text or, until confirmed, the most confident read
+	float textConfidence = 0.f;
+	bool confirmed = false; // The text won't change anymore: further reads are ignored
+	size_t hits = 0; // Frames with a detection
+	size_t misses = 0; // Consecutive frames without detection
+	int64_t firstFrame = -1;
+	int64_t lastFrame = -1;
+
+	struct Candidate {
+		char text[ALPR_PLATE_TEXT_MAX_SIZE];
+		size_t votes;
+	};
+	Candidate candidates[ALPR_TRACK_MAX_CANDIDATES];
+	size_t numCandidates = 0;
+};
+
+/*
+* Assigns stable track ids to the plates across frames (greedy IoU matching on the car box when both have one,
+* on the plate box otherwise) and confirms the text once enough confident reads agree.
+* The engine has no tracking stage: every frame is still detected and recognized. The tracker removes the
+* duplicates on the host side so that a vehicle crossing the scene is reported once, with a single text, and
+* lets the application skip its own per-plate work (lookups, storage, uploads) once the track is confirmed.
+* Not thread-safe: use one tracker per camera.
+*/
+class AlprTracker {
+public:
+	AlprTracker(const AlprTrackerConfig& config = AlprTrackerConfig()) : config_(config) { }
+
+	/*
+	* Matches the plates detected in a frame with the tracks.
+	* @param plates Plates for the frame.
+	* @param frameNo Frame number (e.g. the video frame counter), only stored in the tracks.
+	* @returns the track id for each plate (same order as "plates"), valid until the next call.
+	*/
+	const std::vector<uint64_t>& update(const AlprPlates& plates, const int64_t frameNo) {
+		assignment_.assign(plates.size(), 0);
+		std::vector<bool> trackMatched(tracks_.size(), false);
+
+		// Greedy matching, best overlaps first
+		pairs_.clear();
+		for (size_t p = 0; p < plates.size(); ++p) {
+			for (size_t t = 0; t < tracks_.size(); ++t) {
+				const float overlap = iou(tracks_[t].plate, plates[p]);
+				if (overlap >= config_.minIou) {
+					pairs_.push_back({ overlap, p, t });
+				}
+			}
+		}
+		std::sort(pairs_.begin(), pairs_.end(), [](const AlprTrackPair& a, const AlprTrackPair& b) { return a.iou > b.iou; });
+		for (const AlprTrackPair& pair : pairs_) {
+			if (!assignment_[pair.plate] && !trackMatched[pair.track]) {
+				trackMatched[pair.track] = true;
+				assignment_[pair.plate] = tracks_[pair.track].id;
+				hit(tracks_[pair.track], plates[pair.plate], frameNo);
+			}
+		}
+
+		// Unmatched tracks
+		for (size_t t = 0; t < tracks_.size(); ++t) {
+			if (!trackMatched[t]) {
+				++tracks_[t].misses;
+			}
+		}
+		tracks_.erase(std::remove_if(tracks_.begin(), tracks_.end(), [this](const AlprTrack& track) {
+			return track.misses > config_.maxMisses;
+		}), tracks_.end());
+
+		// Unmatched plates start new tracks
+		for (size_t p = 0; p < plates.size(); ++p) {
+			if (!assignment_[p]) {
+				tracks_.emplace_back();
+				AlprTrack& track = tracks_.back();
+				track.id = nextId_++;
+				track.firstFrame = frameNo;
+				hit(track, plates[p], frameNo);
+				assignment_[p] = track.id;
+			}
+		}
+		return assignment_;
+	}
+
+	/*
+	* Live tracks, including the ones missed in the last frames (up to maxMisses)
+	*/
+	inline const std::vector<AlprTrack>& tracks() const { return tracks_; }
+
+	const AlprTrack* track(const uint64_t id) const {
+		for (const AlprTrack& track : tracks_) {
+			if (track.id == id) {
+				return &track;
+			}
+		}
+		return nullptr;
+	}
+
+	void reset() {
+		tracks_.clear();
+		assignment_.clear();
+	}
+
+	// Overlap of the axis-aligned bounding boxes, on the car boxes when both plates have one
+	static float iou(const AlprPlate& a, const AlprPlate& b) {
+		const bool cars = a.hasCar && b.hasCar;
+		return iou(cars ? a.carWarpedBox : a.warpedBox, cars ? b.carWarpedBox : b.warpedBox);
+	}
+
+	static float iou(const float (&a)[8], const float (&b)[8]) {
+		float ax0, ay0, ax1, ay1, bx0, by0, bx1, by1;
+		bounds(a, ax0, ay0, ax1, ay1);
+		bounds(b, bx0, by0, bx1, by1);
+		const float iw = std::min(ax1, bx1) - std::max(ax0, bx0);
+		const float ih = std::min(ay1, by1) - std::max(ay0, by0);
+		if (iw <= 0.f || ih <= 0.f) {
+			return 0.f;
+		}
+		const float inter = iw * ih;
+		return inter / (((ax1 - ax0) * (ay1 - ay0)) + ((bx1 - bx0) * (by1 - by0)) - inter);
+	}
+
+private:
+	struct AlprTrackPair {
+		float iou;
+		size_t plate;
+		size_t track;
+	};
+
+	static void bounds(const float (&box)[8], float& x0, float& y0, float& x1, float& y1) {
+		x0 = x1 = box[0];
+		y0 = y1 = box[1];
+		for (size_t i = 2; i < 8; i += 2) {
+			x0 = std::min(x0, box[i]);
+			x1 = std::max(x1, box[i]);
+			y0 = std::min(y0, box[i + 1]);
+			y1 = std::max(y1, box[i + 1]);
+		}
+	}
+
+	void hit(AlprTrack& track, const AlprPlate& plate, const int64_t frameNo) {
+		track.plate = plate;
+		track.lastFrame = frameNo;
+		track.misses = 0;
+		++track.hits;
+		if (track.confirmed || !plate.text[0]) {
+			return;
+		}
+		const float confidence = plate.recognitionConfidence();
+		if (!track.text[0] || confidence > track.textConfidence) {
+			memcpy(track.text, plate.text, sizeof(track.text));
+			track.textConfidence = confidence;
+		}
+		if (confidence < config_.confirmConfidence) {
+			return;
+		}
+		// Vote
+		size_t i = 0;
+		for (; i < track.numCandidates && strcmp(track.candidates[i].text, plate.text); ++i) ;
+		if (i == track.numCandidates) {
+			if (track.numCandidates == ALPR_TRACK_MAX_CANDIDATES) {
+				return;
+			}
+			memcpy(track.candidates[i].text, plate.text, sizeof(track.candidates[i].text));
+			track.candidates[i].votes = 0;
+			++track.numCandidates;
+		}
+		if (++track.candidates[i].votes >= config_.confirmHits) {
+			memcpy(track.text, plate.text, sizeof(track.text));
+			track.textConfidence = confidence;
+			track.confirmed = true;
+		}
+	}
+
+	AlprTrackerConfig config_;
+	std::vector<AlprTrack> tracks_;
+	std::vector<uint64_t> assignment_;
+	std::vector<AlprTrackPair> pairs_;
+	uint64_t nextId_ = 1;
+};
+
+#endif /* _ULTIMATE_ALPR_SDK_SAMPLES_TRACKER_H_ */
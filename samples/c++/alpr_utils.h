@@ -5,8 +5,17 @@
 #include <assert.h>
 #include <stdlib.h>
 #include <map>
+#include <algorithm>
+#include <stdint.h>
+#include <vector>
 #include <sys/stat.h>
 #include <codecvt>
+#include <ctype.h>
+#if defined(_WIN32)
+#include <io.h> // _findfirst
+#else
+#include <dirent.h>
+#endif
 
 // Not part of the SDK, used to decode images -> https://github.com/nothings/stb
 #define STB_IMAGE_IMPLEMENTATION
@@ -52,7 +61,7 @@ struct AlprFile {
 * @param height
 * @returns 
 */
-static bool alprDecodeFile(const std::string& path, AlprFile& alprFile)
+static inline bool alprDecodeFile(const std::string& path, AlprFile& alprFile)
 {
 	ULTALPR_SDK_ASSERT(!path.empty());
 
@@ -92,7 +101,154 @@ static bool alprDecodeFile(const std::string& path, AlprFile& alprFile)
 	return true;
 }
 
-static bool alprParseArgs(int argc, char *argv[], std::map<std::string, std::string >& values)
+/*
+* Lists the JPEG/PNG/BMP files (by extension, case-insensitive) in a folder, not recursive
+* @param folder Path to the folder. Not supported for Android assets.
+* @param paths Full path for each file, sorted by name.
+* @returns true if the folder could be opened, false otherwise.
+*/
+static inline bool alprListImageFiles(const std::string& folder, std::vector<std::string>& paths)
+{
+	ULTALPR_SDK_ASSERT(!folder.empty());
+	static const char* extensions[] = { "jpg", "jpeg", "png", "bmp" };
+	const char last = folder[folder.size() - 1];
+	const std::string prefix = (last == '/' || last == '\\') ? folder : (folder + "/");
+	std::vector<std::string> names;
+#if defined(_WIN32)
+	struct _finddata_t entry;
+	const intptr_t handle = _findfirst((prefix + "*").c_str(), &entry);
+	if (handle == -1) {
+		ULTALPR_SDK_PRINT_ERROR("Failed to open folder at: %s", folder.c_str());
+		return false;
+	}
+	do {
+		if (!(entry.attrib & _A_SUBDIR)) {
+			names.push_back(entry.name);
+		}
+	} while (_findnext(handle, &entry) == 0);
+	_findclose(handle);
+#else
+	DIR* dir = opendir(folder.c_str());
+	if (!dir) {
+		ULTALPR_SDK_PRINT_ERROR("Failed to open folder at: %s", folder.c_str());
+		return false;
+	}
+	for (struct dirent* entry = readdir(dir); entry; entry = readdir(dir)) {
+		names.push_back(entry->d_name);
+	}
+	closedir(dir);
+#endif
+	std::sort(names.begin(), names.end());
+	paths.clear();
+	for (const std::string& name : names) {
+		const size_t dot = name.find_last_of('.');
+		if (dot == std::string::npos || dot == 0) {
+			continue;
+		}
+		std::string extension = name.substr(dot + 1);
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+		for (const char* supported : extensions) {
+			if (extension == supported) {
+				paths.push_back(prefix + name);
+				break;
+			}
+		}
+	}
+	return true;
+}
+
+/*
+* Number of bytes per sample for the packed formats, 0 for the planar and semi-planar (YUV-family) formats
+*/
+static inline size_t alprBytesPerSample(const ULTALPR_SDK_IMAGE_TYPE type)
+{
+	switch (type) {
+	case ULTALPR_SDK_IMAGE_TYPE_RGB24:
+	case ULTALPR_SDK_IMAGE_TYPE_BGR24:
+		return 3;
+	case ULTALPR_SDK_IMAGE_TYPE_RGBA32:
+	case ULTALPR_SDK_IMAGE_TYPE_BGRA32:
+		return 4;
+	case ULTALPR_SDK_IMAGE_TYPE_Y:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+/*
+* Frame description used for batched processing. Packed formats (RGB-family, Y) only use
+* data[0] and strides[0] (stride in samples). Planar and semi-planar (YUV-family) formats
+* use the three planes with strides in bytes, as expected by \ref UltAlprSdkEngine::process.
+*/
+struct AlprFrame {
+	ULTALPR_SDK_IMAGE_TYPE type = ULTALPR_SDK_IMAGE_TYPE_RGB24;
+	const void* data[3] = { nullptr, nullptr, nullptr };
+	size_t width = 0;
+	size_t height = 0;
+	size_t strides[3] = { 0, 0, 0 };
+	size_t uvPixelStrideInBytes = 0;
+	int exifOrientation = 1;
+
+	AlprFrame() { }
+	AlprFrame(const AlprFile& file) : type(file.type), width(file.width), height(file.height) {
+		data[0] = file.uncompressedData;
+	}
+
+	inline bool isPlanar() const {
+		return (data[1] != nullptr);
+	}
+};
+
+/*
+* Processes a single frame, using the packed or planar overload depending on the frame description.
+* @param frame Frame to process.
+* @returns the result from the engine.
+*/
+static inline UltAlprSdkResult alprProcessFrame(const AlprFrame& frame)
+{
+	if (frame.isPlanar()) {
+		return UltAlprSdkEngine::process(
+			frame.type,
+			frame.data[0], frame.data[1], frame.data[2],
+			frame.width, frame.height,
+			frame.strides[0], frame.strides[1], frame.strides[2],
+			frame.uvPixelStrideInBytes,
+			frame.exifOrientation
+		);
+	}
+	return UltAlprSdkEngine::process(
+		frame.type,
+		frame.data[0],
+		frame.width, frame.height,
+		frame.strides[0],
+		frame.exifOrientation
+	);
+}
+
+/*
+* Processes a list of frames and returns one result per frame (same order).
+* Convenience loop over alprProcessFrame(): the engine has no batch API, the frames are processed
+* one by one and the throughput is the same as calling process() for each frame.
+* @param frames Frames to process.
+* @param count Number of frames.
+* @param results Results, one per frame.
+* @returns true if all frames were successfully processed, false otherwise.
+*/
+static inline bool alprProcessBatch(const AlprFrame* frames, const size_t count, std::vector<UltAlprSdkResult>& results)
+{
+	ULTALPR_SDK_ASSERT(frames != nullptr || count == 0);
+
+	bool ok = true;
+	results.resize(count);
+	for (size_t i = 0; i < count; ++i) {
+		results[i] = alprProcessFrame(frames[i]);
+		ok &= results[i].isOK();
+	}
+	return ok;
+}
+
+static inline bool alprParseArgs(int argc, char *argv[], std::map<std::string, std::string >& values)
 {
 	ULTALPR_SDK_ASSERT(argc > 0 && argv != nullptr);
 
@@ -0,0 +1,109 @@
+#if !defined(_ULTIMATE_ALPR_SDK_SAMPLES_WARMUP_H_)
+#define _ULTIMATE_ALPR_SDK_SAMPLES_WARMUP_H_
+
+#include <ultimateALPR-SDK-API-PUBLIC.h>
+#include "alpr_utils.h"
+#include "alpr_stats.h"
+#include <string.h>
+#include <vector>
+
+using namespace ultimateAlprSdk;
+
+/*
+* Frame shape to warm up: the engine specializes its buffers for each (type, width, height, stride)
+*/
+struct AlprWarmUpShape {
+	ULTALPR_SDK_IMAGE_TYPE type = ULTALPR_SDK_IMAGE_TYPE_RGB24;
+	size_t width = 0;
+	size_t height = 0;
+	size_t stride = 0; // In samples, zero means same as width
+};
+
+struct AlprWarmUpTiming {
+	AlprWarmUpShape shape;
+	double millis = 0.0; // First blank frame: allocations and shape specialization
+	double steadyMillis = 0.0; // Second blank frame, should be close to the steady-state latency
+	bool ok = false;
+};
+
+/*
+* Size in bytes of a contiguous frame (luma followed by the chroma planes for the YUV-family formats)
+*/
+static inline size_t alprFrameSizeInBytes(const ULTALPR_SDK_IMAGE_TYPE type, const size_t stride, const size_t height, size_t& lumaSize)
+{
+	const size_t bytesPerSample = alprBytesPerSample(type);
+	lumaSize = stride * height * (bytesPerSample ? bytesPerSample : 1);
+	switch (type) {
+	case ULTALPR_SDK_IMAGE_TYPE_NV12:
+	case ULTALPR_SDK_IMAGE_TYPE_NV21:
+	case ULTALPR_SDK_IMAGE_TYPE_YUV420P:
+	case ULTALPR_SDK_IMAGE_TYPE_YVU420P:
+		return lumaSize + (stride + 1) * ((height + 1) >> 1);
+	case ULTALPR_SDK_IMAGE_TYPE_YUV422P:
+		return lumaSize << 1;
+	case ULTALPR_SDK_IMAGE_TYPE_YUV444P:
+		return lumaSize * 3;
+	default:
+		return lumaSize;
+	}
+}
+
+/*
+* Resolution-aware warm up. \ref UltAlprSdkEngine::warmUp only loads the models for an image type: the
+* first real frame at each new resolution still pays the allocations and shape specialization. This
+* function runs blank frames for every shape so that the first production frame runs at steady-state latency.
+* The engine must be initialized. Blank frames are processed as any other frame. In parallel mode process() only
+* queues them: the timings are the time to queue and, the frames having no plate, the delivery callback is never
+* invoked for them. To make sure they're processed before timing anything, queue a frame with plates and wait for
+* its delivery, or warm up in sequential mode.
+* @param shapes Shapes expected in production (e.g. each camera resolution).
+* @param count Number of shapes.
+* @param timings Warm up time for each shape (same order).
+* @returns true if all shapes were successfully warmed up, false otherwise.
+*/
+static inline bool alprWarmUp(const AlprWarmUpShape* shapes, const size_t count, std::vector<AlprWarmUpTiming>& timings)
+{
+	ULTALPR_SDK_ASSERT(shapes != nullptr || count == 0);
+
+	bool ok = true;
+	std::vector<ULTALPR_SDK_IMAGE_TYPE> types;
+	std::vector<uint8_t> blank;
+	timings.resize(count);
+	for (size_t i = 0; i < count; ++i) {
+		const AlprWarmUpShape& shape = shapes[i];
+		AlprWarmUpTiming& timing = timings[i];
+		timing = AlprWarmUpTiming();
+		timing.shape = shape;
+		const size_t stride = shape.stride ? shape.stride : shape.width;
+		if (!shape.width || !shape.height || stride < shape.width) {
+			ULTALPR_SDK_PRINT_ERROR("Invalid warm up shape (%zu x %zu, stride %zu)", shape.width, shape.height, shape.stride);
+			ok = false;
+			continue;
+		}
+		// Models for this type
+		if (std::find(types.begin(), types.end(), shape.type) == types.end()) {
+			if (!UltAlprSdkEngine::warmUp(shape.type).isOK()) {
+				ok = false;
+				continue;
+			}
+			types.push_back(shape.type);
+		}
+		// Black frame: zero luma/RGB, neutral chroma
+		size_t lumaSize;
+		blank.resize(alprFrameSizeInBytes(shape.type, stride, shape.height, lumaSize));
+		memset(blank.data(), 0, lumaSize);
+		memset(blank.data() + lumaSize, 128, blank.size() - lumaSize);
+		double* durations[2] = { &timing.millis, &timing.steadyMillis };
+		timing.ok = true;
+		for (size_t k = 0; k < 2; ++k) {
+			const AlprStopwatch stopwatch;
+			const UltAlprSdkResult result = UltAlprSdkEngine::process(shape.type, blank.data(), shape.width, shape.height, shape.stride);
+			*durations[k] = stopwatch.micros() / 1000.0;
+			timing.ok &= result.isOK();
+		}
+		ok &= timing.ok;
+	}
+	return ok;
+}
+
+#endif /* _ULTIMATE_ALPR_SDK_SAMPLES_WARMUP_H_ */
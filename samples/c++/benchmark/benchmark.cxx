@@ -12,6 +12,17 @@
 		benchmark \
 			--positive <path-to-image-with-a-plate> \
 			--negative <path-to-image-without-a-plate> \
+			[--corpus <path-to-folder-with-images>] \
+			[--order <corpus-replay-order:random/fixed>] \
+			[--report <report-format:json/csv>] \
+			[--report_file <path-to-report-file>] \
+			[--baseline <path-to-json-report-from-a-previous-run>] \
+			[--max_regression <max-regression-in-percent:[0.0, inf]>] \
+			[--sweep <parameter-grid:option=value,value;option=value...>] \
+			[--latency_bound <max-p99-latency-in-millis>] \
+			[--target_fps <frame-rates-per-stream:fps,fps...>] \
+			[--streams <number-of-streams:[1, inf]>] \
+			[--producers <max-number-of-producer-threads:[1, inf]/cores>] \
 			[--assets <path-to-assets-folder>] \
 			[--charset <recognition-charset:latin/korean/chinese>] \
 			[--num_threads <number of threads:[1, inf]>] \
@@ -26,6 +37,7 @@
 			[--klass_vmmr_enabled <whether-to-enable-VMMR:true/false>] \
 			[--klass_vbsr_enabled <whether-to-enable-VBSR:true/false>] \
 			[--loops <number-of-times-to-run-the-loop:[1, inf]>] \
+			[--batch_size <number-of-frames-per-batch:[1, inf]>] \
 			[--rate <positive-rate:[0.0, 1.0]>] \
 			[--parallel <whether-to-enable-parallel-mode:true/false>] \
 			[--rectify <whether-to-enable-rectification-layer:true/false>] \
@@ -47,11 +59,19 @@
 
 #include <ultimateALPR-SDK-API-PUBLIC.h>
 #include "../alpr_utils.h"
+#include "../alpr_warmup.h"
+#include "../alpr_async.h"
+#include "../alpr_json.h"
+#include "../alpr_plates.h"
 #include <chrono>
+#include <cmath>
+#include <map>
 #include <vector>
 #include <algorithm>
 #include <random>
 #include <mutex>
+#include <thread>
+#include <atomic>
 #include <condition_variable>
 #if defined(_WIN32)
 #include <algorithm> // std::replace
@@ -99,15 +119,285 @@ static const char* __jsonConfig =
 // Including <Windows.h> add clashes between "std::max" and "::max"
 #define ULTAPR_MAX(a, b) (((a) > (b)) ? (a) : (b))
 
+/*
+* Per-frame timestamps. In parallel mode process() only queues the frame: the result is matched
+* to its frame using the "frame_id" returned by process() and the one from the delivery callback.
+*/
+struct BenchmarkFrameTiming {
+	size_t file = 0; // Index in BenchmarkInput::files
+	size_t group = 0; // Negative/positive or, in corpus mode, size bucket
+	int64_t frameId = -1;
+	std::chrono::high_resolution_clock::time_point submitted; // process() called
+	std::chrono::high_resolution_clock::time_point returned; // process() returned
+};
+static std::mutex deliveryMutex;
+static std::map<int64_t, std::chrono::high_resolution_clock::time_point> deliveries; // frame_id -> delivery time
+
+/*
+* Latency summary, in milliseconds. Percentiles use the nearest-rank method.
+*/
+struct BenchmarkLatency {
+	size_t count = 0;
+	double min = 0.0, p50 = 0.0, p90 = 0.0, p99 = 0.0, max = 0.0;
+};
+
+static BenchmarkLatency benchmarkLatency(std::vector<double>& millis)
+{
+	BenchmarkLatency latency;
+	if ((latency.count = millis.size()) == 0) {
+		return latency;
+	}
+	std::sort(millis.begin(), millis.end());
+	const auto percentile = [&millis](const double p) {
+		const size_t rank = static_cast<size_t>(std::ceil(p * millis.size()));
+		return millis[rank ? (rank - 1) : 0];
+	};
+	latency.min = millis.front();
+	latency.p50 = percentile(0.50);
+	latency.p90 = percentile(0.90);
+	latency.p99 = percentile(0.99);
+	latency.max = millis.back();
+	return latency;
+}
+
+/*
+* Size buckets for the corpus mode, by number of pixels
+*/
+static const char* benchmarkSizeBucketNames[] = { "<=VGA", "<=720p", "<=1080p", "<=4K", ">4K" };
+static size_t benchmarkSizeBucket(const size_t width, const size_t height)
+{
+	static const size_t maxPixels[] = { 640 * 480, 1280 * 720, 1920 * 1080, 3840 * 2160 };
+	size_t bucket = 0;
+	for (; bucket < sizeof(maxPixels) / sizeof(maxPixels[0]) && (width * height) > maxPixels[bucket]; ++bucket);
+	return bucket;
+}
+
+/*
+* Results of the timed loop, written with --report and checked with --baseline
+*/
+struct BenchmarkRun {
+	std::vector<std::pair<std::string, std::string> > config; // Option (without "--") -> value
+	size_t frames = 0;
+	double elapsedMillis = 0.0;
+	double fps = 0.0;
+	std::vector<std::string> groupNames; // "negative"/"positive" or the corpus size buckets
+	std::vector<BenchmarkLatency> latencies; // Per group
+	size_t undelivered = 0; // Parallel mode: frames expected but not delivered. Open loop: dropped frames
+	size_t late = 0; // Open loop only
+	double residentMb = 0.0;
+	double peakResidentMb = 0.0;
+};
+
+// JSON numbers and booleans are written as is, everything else (including "inf" or "nan") as a string
+static void benchmarkJsonWriteValue(std::string& out, const std::string& value)
+{
+	if (value == "true" || value == "false" || alprJsonIsNumber(value.c_str())) {
+		out += value;
+	}
+	else {
+		alprJsonWriteString(out, value.c_str());
+	}
+}
+
+// Quoted when containing a separator, a quote or a line break (RFC 4180)
+static void benchmarkCsvWriteValue(std::string& out, const std::string& value)
+{
+	if (value.find_first_of(",\"\r\n") == std::string::npos) {
+		out += value;
+		return;
+	}
+	out += '"';
+	for (const char c : value) {
+		out += c;
+		if (c == '"') {
+			out += '"';
+		}
+	}
+	out += '"';
+}
+
+static std::string benchmarkNumber(const double value)
+{
+	char buffer[32];
+	snprintf(buffer, sizeof(buffer), "%.3f", value);
+	return buffer;
+}
+
+/*
+* Flattens a run (and the host description) into named columns, in the same order as the JSON report
+*/
+static void benchmarkReportColumns(const BenchmarkRun& run, std::vector<std::pair<std::string, std::string> >& columns)
+{
+	columns = run.config;
+	columns.push_back(std::make_pair("cpu", alprCpuName()));
+	columns.push_back(std::make_pair("cores", std::to_string(std::thread::hardware_concurrency())));
+	columns.push_back(std::make_pair("frames", std::to_string(run.frames)));
+	columns.push_back(std::make_pair("elapsed_millis", benchmarkNumber(run.elapsedMillis)));
+	columns.push_back(std::make_pair("fps", benchmarkNumber(run.fps)));
+	for (size_t i = 0; i < run.groupNames.size(); ++i) {
+		const BenchmarkLatency& latency = run.latencies[i];
+		const std::string prefix = "latency_" + run.groupNames[i] + "_";
+		columns.push_back(std::make_pair(prefix + "count", std::to_string(latency.count)));
+		columns.push_back(std::make_pair(prefix + "min", benchmarkNumber(latency.min)));
+		columns.push_back(std::make_pair(prefix + "p50", benchmarkNumber(latency.p50)));
+		columns.push_back(std::make_pair(prefix + "p90", benchmarkNumber(latency.p90)));
+		columns.push_back(std::make_pair(prefix + "p99", benchmarkNumber(latency.p99)));
+		columns.push_back(std::make_pair(prefix + "max", benchmarkNumber(latency.max)));
+	}
+	columns.push_back(std::make_pair("undelivered", std::to_string(run.undelivered)));
+	columns.push_back(std::make_pair("late", std::to_string(run.late)));
+	columns.push_back(std::make_pair("resident_mb", benchmarkNumber(run.residentMb)));
+	columns.push_back(std::make_pair("peak_resident_mb", benchmarkNumber(run.peakResidentMb)));
+}
+
+/*
+* CSV report: header line (optional) followed by one line for the run
+*/
+static void benchmarkReportCsv(const BenchmarkRun& run, const bool header, std::string& out)
+{
+	std::vector<std::pair<std::string, std::string> > columns;
+	benchmarkReportColumns(run, columns);
+	for (size_t line = header ? 0 : 1; line < 2; ++line) {
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (i) {
+				out += ',';
+			}
+			benchmarkCsvWriteValue(out, line ? columns[i].second : columns[i].first);
+		}
+		out += '\n';
+	}
+}
+
+/*
+* JSON report: {"config":{...},"host":{...},"throughput":{...},"latency":{"<group>":{...}},"undelivered":n,"late":n,"memory":{...}}
+*/
+static void benchmarkReportJson(const BenchmarkRun& run, std::string& out)
+{
+	bool first = true;
+	out += "{\"config\":{";
+	for (const std::pair<std::string, std::string>& option : run.config) {
+		alprJsonWriteKey(out, first, option.first.c_str());
+		benchmarkJsonWriteValue(out, option.second);
+	}
+	out += "},\"host\":{\"cpu\":";
+	alprJsonWriteString(out, alprCpuName().c_str());
+	out += ",\"cores\":" + std::to_string(std::thread::hardware_concurrency());
+	out += "},\"throughput\":{\"frames\":" + std::to_string(run.frames)
+		+ ",\"elapsed_millis\":" + benchmarkNumber(run.elapsedMillis)
+		+ ",\"fps\":" + benchmarkNumber(run.fps) + "},\"latency\":{";
+	first = true;
+	for (size_t i = 0; i < run.groupNames.size(); ++i) {
+		const BenchmarkLatency& latency = run.latencies[i];
+		alprJsonWriteKey(out, first, run.groupNames[i].c_str());
+		out += "{\"count\":" + std::to_string(latency.count)
+			+ ",\"min\":" + benchmarkNumber(latency.min)
+			+ ",\"p50\":" + benchmarkNumber(latency.p50)
+			+ ",\"p90\":" + benchmarkNumber(latency.p90)
+			+ ",\"p99\":" + benchmarkNumber(latency.p99)
+			+ ",\"max\":" + benchmarkNumber(latency.max) + "}";
+	}
+	out += "},\"undelivered\":" + std::to_string(run.undelivered)
+		+ ",\"late\":" + std::to_string(run.late)
+		+ ",\"memory\":{\"resident_mb\":" + benchmarkNumber(run.residentMb)
+		+ ",\"peak_resident_mb\":" + benchmarkNumber(run.peakResidentMb) + "}}\n";
+}
+
+/*
+* Compares a run with a JSON report from a previous run (--report json).
+* Regression: throughput lower than the baseline or p50/p90/p99 latency higher than the baseline by more
+* than "maxRegressionPercent". Latency groups missing or empty on either side are not compared.
+* A run with undelivered frames (parallel mode) always fails: its percentiles don't cover all the frames.
+* @returns true if there's no regression, false otherwise (or if the baseline cannot be read).
+*/
+static bool benchmarkCheckBaseline(const std::string& path, const BenchmarkRun& run, const double maxRegressionPercent)
+{
+	FILE* file = fopen(path.c_str(), "rb");
+	if (!file) {
+		ULTALPR_SDK_PRINT_ERROR("Failed to open baseline file at: %s", path.c_str());
+		return false;
+	}
+	std::string json;
+	char buffer[4096];
+	for (size_t read; (read = fread(buffer, 1, sizeof(buffer), file)) > 0; ) {
+		json.append(buffer, read);
+	}
+	fclose(file);
+
+	// Reads the numbers of a flat object ("throughput" or a latency group)
+	const auto readNumbers = [](const char* begin, const char* end, std::map<std::string, double>& numbers) {
+		const std::string object(begin, end);
+		return alprJsonForEachMember(object.c_str(), [&numbers](const char* key, const char* valueBegin, const char* valueEnd) {
+			AlprJsonCursor c(valueBegin, valueEnd);
+			double value;
+			if (alprJsonReadNumber(c, value)) {
+				numbers[key] = value;
+			}
+		});
+	};
+	std::map<std::string, double> throughput;
+	std::map<std::string, std::map<std::string, double> > latencies;
+	bool parsed = alprJsonForEachMember(json.c_str(), [&](const char* key, const char* valueBegin, const char* valueEnd) {
+		if (!strcmp(key, "throughput")) {
+			readNumbers(valueBegin, valueEnd, throughput);
+		}
+		else if (!strcmp(key, "latency")) {
+			const std::string object(valueBegin, valueEnd);
+			alprJsonForEachMember(object.c_str(), [&](const char* group, const char* groupBegin, const char* groupEnd) {
+				readNumbers(groupBegin, groupEnd, latencies[group]);
+			});
+		}
+	});
+	if (!parsed || throughput.find("fps") == throughput.end()) {
+		ULTALPR_SDK_PRINT_ERROR("Invalid baseline file (expecting a JSON report): %s", path.c_str());
+		return false;
+	}
+
+	bool ok = true;
+	if (run.undelivered) {
+		ULTALPR_SDK_PRINT_ERROR("%zu frame(s) without delivery, the latency is incomplete", run.undelivered);
+		ok = false;
+	}
+	const double tolerance = maxRegressionPercent / 100.0;
+	const double baselineFps = throughput["fps"];
+	if (run.fps < baselineFps * (1.0 - tolerance)) {
+		ULTALPR_SDK_PRINT_ERROR("Throughput regression: %lf fps (baseline: %lf fps)", run.fps, baselineFps);
+		ok = false;
+	}
+	for (size_t i = 0; i < run.groupNames.size(); ++i) {
+		const auto group = latencies.find(run.groupNames[i]);
+		const BenchmarkLatency& latency = run.latencies[i];
+		if (group == latencies.end() || !latency.count || group->second["count"] <= 0.0) {
+			continue;
+		}
+		const std::pair<const char*, double> percentiles[3] = { { "p50", latency.p50 }, { "p90", latency.p90 }, { "p99", latency.p99 } };
+		for (const std::pair<const char*, double>& percentile : percentiles) {
+			const double baselineMillis = group->second[percentile.first];
+			if (percentile.second > baselineMillis * (1.0 + tolerance)) {
+				ULTALPR_SDK_PRINT_ERROR("Latency regression (%s, %s): %lf millis (baseline: %lf millis)",
+					run.groupNames[i].c_str(), percentile.first, percentile.second, baselineMillis);
+				ok = false;
+			}
+		}
+	}
+	ULTALPR_SDK_PRINT_INFO("Baseline %s: %s (max regression: %lf%%)", path.c_str(), ok ? "passed" : "FAILED", maxRegressionPercent);
+	return ok;
+}
+
 /*
 * Parallel callback function used for notification. Not mandatory.
 * More info about parallel delivery: https://www.doubango.org/SDKs/anpr/docs/Parallel_versus_sequential_processing.html
 */
-static size_t parallelNotifCount = 0;
+static std::atomic<size_t> parallelNotifCount(0);
 static std::condition_variable parallelNotifCondVar;
 class MyUltAlprSdkParallelDeliveryCallback : public UltAlprSdkParallelDeliveryCallback {
 	virtual void onNewResult(const UltAlprSdkResult* result) const override {
+		const std::chrono::high_resolution_clock::time_point now = std::chrono::high_resolution_clock::now();
 		ULTALPR_SDK_ASSERT(result != nullptr);
+		const int64_t frameId = alprJsonFrameId(result->json());
+		if (frameId >= 0) {
+			std::lock_guard<std::mutex> lock(deliveryMutex);
+			deliveries[frameId] = now;
+		}
 		const std::string& json = result->json();
 		// Printing to the console could be very slow and delayed -> stop displaying the result as soon as all plates are processed
 		ULTALPR_SDK_PRINT_INFO("MyUltAlprSdkParallelDeliveryCallback::onNewResult(%d, %s, %zu): %s",
@@ -123,13 +413,9 @@ class MyUltAlprSdkParallelDeliveryCallback : public UltAlprSdkParallelDeliveryCa
 static void printUsage(const std::string& message = "");
 
 /*
-* Entry point
+* Engine options, from the command line or from a --sweep grid point
 */
-int main(int argc, char *argv[])
-{
-	// local variables
-	UltAlprSdkResult result;
-	MyUltAlprSdkParallelDeliveryCallback parallelDeliveryCallbackCallback;
+struct BenchmarkOptions {
 	std::string assetsFolder, licenseTokenData, licenseTokenFile;
 	bool isParallelDeliveryEnabled = true;
 	std::string numThreads = "-1";
@@ -150,186 +436,422 @@ int main(int argc, char *argv[])
 	bool isKlassVBSR_Enabled = false;
 	std::string charset = "latin";
 	std::string openvinoDevice = "CPU";
-	size_t loopCount = 100;
-	double percentPositives = .2; // 20%
-	std::string pathFilePositive;
-	std::string pathFileNegative;
+	size_t batchSize = 1;
+};
 
-	// Parsing args
-	std::map<std::string, std::string > args;
-	if (!alprParseArgs(argc, argv, args)) {
-		printUsage();
-		return -1;
-	}
-	if (args.find("--positive") == args.end()) {
-		printUsage("--positive required");
-		return -1;
-	}
-	if (args.find("--negative") == args.end()) {
-		printUsage("--negative required");
-		return -1;
-	}
-	pathFilePositive = args["--positive"];
-	pathFileNegative = args["--negative"];
-	if (args.find("--rate") != args.end()) {
-		const double rate = std::atof(args["--rate"].c_str());
-		if (rate > 1.0 || rate < 0.0) {
-			printUsage("--rate must be within [0.0, 1.0]");
-			return -1;
-		}
-		percentPositives = rate;
-	}
-	if (args.find("--loops") != args.end()) {
-		const int loops = std::atoi(args["--loops"].c_str());
-		if (loops < 1) {
-			printUsage("--loops must be within [1, inf]");
-			return -1;
+// Options accepted in a --sweep grid (without "--")
+static const char* benchmarkSweepOptions[] = {
+	"num_threads", "parallel", "rectify", "ienv_enabled", "openvino_enabled", "openvino_device", "npu_enabled", "trt_enabled",
+	"simd_enabled", "klass_lpci_enabled", "klass_vcr_enabled", "klass_vmmr_enabled", "klass_vbsr_enabled", "charset"
+};
+
+/*
+* Parses the engine options
+* @returns false if an option is invalid (usage already printed), true otherwise.
+*/
+static bool benchmarkParseOptions(std::map<std::string, std::string >& args, BenchmarkOptions& options)
+{
+	if (args.find("--batch_size") != args.end()) {
+		const int batch = std::atoi(args["--batch_size"].c_str());
+		if (batch < 1) {
+			printUsage("--batch_size must be within [1, inf]");
+			return false;
 		}
-		loopCount = static_cast<size_t>(loops);
+		options.batchSize = static_cast<size_t>(batch);
 	}
 	if (args.find("--parallel") != args.end()) {
-		isParallelDeliveryEnabled = (args["--parallel"].compare("true") == 0);
+		options.isParallelDeliveryEnabled = (args["--parallel"].compare("true") == 0);
 	}
 	if (args.find("--assets") != args.end()) {
-		assetsFolder = args["--assets"];
+		options.assetsFolder = args["--assets"];
 #if defined(_WIN32)
-		std::replace(assetsFolder.begin(), assetsFolder.end(), '\\', '/');
+		std::replace(options.assetsFolder.begin(), options.assetsFolder.end(), '\\', '/');
 #endif
 	}
 	if (args.find("--charset") != args.end()) {
-		charset = args["--charset"];
+		options.charset = args["--charset"];
 	}
 	if (args.find("--num_threads") != args.end()) {
-		numThreads = args["--num_threads"];
+		options.numThreads = args["--num_threads"];
 	}
 	if (args.find("--rectify") != args.end()) {
-		isRectificationEnabled = (args["--rectify"].compare("true") == 0);
+		options.isRectificationEnabled = (args["--rectify"].compare("true") == 0);
 	}
 	if (args.find("--ienv_enabled") != args.end()) {
-		isIENVEnabled = (args["--ienv_enabled"].compare("true") == 0);
+		options.isIENVEnabled = (args["--ienv_enabled"].compare("true") == 0);
 	}
 	if (args.find("--openvino_enabled") != args.end()) {
-		isOpenVinoEnabled = (args["--openvino_enabled"].compare("true") == 0);
+		options.isOpenVinoEnabled = (args["--openvino_enabled"].compare("true") == 0);
 	}
 	if (args.find("--openvino_device") != args.end()) {
-		openvinoDevice = args["--openvino_device"];
+		options.openvinoDevice = args["--openvino_device"];
 	}
 	if (args.find("--npu_enabled") != args.end()) {
-		isNpuEnabled = (args["--npu_enabled"].compare("true") == 0);
+		options.isNpuEnabled = (args["--npu_enabled"].compare("true") == 0);
 	}
 	if (args.find("--trt_enabled") != args.end()) {
-		isTensorRTEnabled = (args["--trt_enabled"].compare("true") == 0);
+		options.isTensorRTEnabled = (args["--trt_enabled"].compare("true") == 0);
 	}
 	if (args.find("--simd_enabled") != args.end()) {
-		isSimdEnabled = (args["--simd_enabled"].compare("true") == 0);
+		options.isSimdEnabled = (args["--simd_enabled"].compare("true") == 0);
 	}
 	if (args.find("--klass_lpci_enabled") != args.end()) {
-		isKlassLPCI_Enabled = (args["--klass_lpci_enabled"].compare("true") == 0);
+		options.isKlassLPCI_Enabled = (args["--klass_lpci_enabled"].compare("true") == 0);
 	}
 	if (args.find("--klass_vcr_enabled") != args.end()) {
-		isKlassVCR_Enabled = (args["--klass_vcr_enabled"].compare("true") == 0);
+		options.isKlassVCR_Enabled = (args["--klass_vcr_enabled"].compare("true") == 0);
 	}
 	if (args.find("--klass_vmmr_enabled") != args.end()) {
-		isKlassVMMR_Enabled = (args["--klass_vmmr_enabled"].compare("true") == 0);
+		options.isKlassVMMR_Enabled = (args["--klass_vmmr_enabled"].compare("true") == 0);
 	}
 	if (args.find("--klass_vbsr_enabled") != args.end()) {
-		isKlassVBSR_Enabled = (args["--klass_vbsr_enabled"].compare("true") == 0);
+		options.isKlassVBSR_Enabled = (args["--klass_vbsr_enabled"].compare("true") == 0);
 	}
 	if (args.find("--tokenfile") != args.end()) {
-		licenseTokenFile = args["--tokenfile"];
+		options.licenseTokenFile = args["--tokenfile"];
 #if defined(_WIN32)
-		std::replace(licenseTokenFile.begin(), licenseTokenFile.end(), '\\', '/');
+		std::replace(options.licenseTokenFile.begin(), options.licenseTokenFile.end(), '\\', '/');
 #endif
 	}
 	if (args.find("--tokendata") != args.end()) {
-		licenseTokenData = args["--tokendata"];
+		options.licenseTokenData = args["--tokendata"];
 	}
-	
+	return true;
+}
 
-	// Update JSON config
+/*
+* Engine JSON config for the options
+*/
+static std::string benchmarkJsonConfig(const BenchmarkOptions& options)
+{
 	std::string jsonConfig = __jsonConfig;
-	if (!assetsFolder.empty()) {
-		jsonConfig += std::string(",\"assets_folder\": \"") + assetsFolder + std::string("\"");
-	}
-	if (!charset.empty()) {
-		jsonConfig += std::string(",\"charset\": \"") + charset + std::string("\"");
-	}
-	jsonConfig += std::string(",\"num_threads\": ") + (numThreads);
-	jsonConfig += std::string(",\"recogn_rectify_enabled\": ") + (isRectificationEnabled ? "true" : "false");	
-	jsonConfig += std::string(",\"ienv_enabled\": ") + (isIENVEnabled ? "true" : "false");
-	jsonConfig += std::string(",\"openvino_enabled\": ") + (isOpenVinoEnabled ? "true" : "false");
-	if (!openvinoDevice.empty()) {
-		jsonConfig += std::string(",\"openvino_device\": \"") + openvinoDevice + std::string("\"");
-	}
-	jsonConfig += std::string(",\"npu_enabled\": ") + (isNpuEnabled ? "true" : "false");
-	jsonConfig += std::string(",\"trt_enabled\": ") + (isTensorRTEnabled ? "true" : "false");
-	jsonConfig += std::string(",\"asm_enabled\": ") + (isSimdEnabled ? "true" : "false");
-	jsonConfig += std::string(",\"intrin_enabled\": ") + (isSimdEnabled ? "true" : "false");
-	jsonConfig += std::string(",\"klass_lpci_enabled\": ") + (isKlassLPCI_Enabled ? "true" : "false");
-	jsonConfig += std::string(",\"klass_vcr_enabled\": ") + (isKlassVCR_Enabled ? "true" : "false");
-	jsonConfig += std::string(",\"klass_vmmr_enabled\": ") + (isKlassVMMR_Enabled ? "true" : "false");
-	jsonConfig += std::string(",\"klass_vbsr_enabled\": ") + (isKlassVBSR_Enabled ? "true" : "false");
-	if (!licenseTokenFile.empty()) {
-		jsonConfig += std::string(",\"license_token_file\": \"") + licenseTokenFile + std::string("\"");
-	}
-	if (!licenseTokenData.empty()) {
-		jsonConfig += std::string(",\"license_token_data\": \"") + licenseTokenData + std::string("\"");
-	}
-	
-	jsonConfig += "}"; // end-of-config
-
-	// Read files
-	// Positive: the file contains at least one plate
-	// Negative: the file doesn't contain a plate
-	// Change positive rates to evaluate the detector versus recognizer
-	AlprFile filePositive, fileNegative;
-	if (!alprDecodeFile(pathFilePositive, filePositive)) {
-		ULTALPR_SDK_PRINT_INFO("Failed to read positive file: %s", pathFilePositive.c_str());
-		return -1;
+	if (!options.assetsFolder.empty()) {
+		jsonConfig += std::string(",\"assets_folder\": \"") + options.assetsFolder + std::string("\"");
 	}
-	if (!alprDecodeFile(pathFileNegative, fileNegative)) {
-		ULTALPR_SDK_PRINT_INFO("Failed to read positive file: %s", pathFilePositive.c_str());
-		return -1;
+	if (!options.charset.empty()) {
+		jsonConfig += std::string(",\"charset\": \"") + options.charset + std::string("\"");
+	}
+	jsonConfig += std::string(",\"num_threads\": ") + (options.numThreads);
+	jsonConfig += std::string(",\"recogn_rectify_enabled\": ") + (options.isRectificationEnabled ? "true" : "false");
+	jsonConfig += std::string(",\"ienv_enabled\": ") + (options.isIENVEnabled ? "true" : "false");
+	jsonConfig += std::string(",\"openvino_enabled\": ") + (options.isOpenVinoEnabled ? "true" : "false");
+	if (!options.openvinoDevice.empty()) {
+		jsonConfig += std::string(",\"openvino_device\": \"") + options.openvinoDevice + std::string("\"");
+	}
+	jsonConfig += std::string(",\"npu_enabled\": ") + (options.isNpuEnabled ? "true" : "false");
+	jsonConfig += std::string(",\"trt_enabled\": ") + (options.isTensorRTEnabled ? "true" : "false");
+	jsonConfig += std::string(",\"asm_enabled\": ") + (options.isSimdEnabled ? "true" : "false");
+	jsonConfig += std::string(",\"intrin_enabled\": ") + (options.isSimdEnabled ? "true" : "false");
+	jsonConfig += std::string(",\"klass_lpci_enabled\": ") + (options.isKlassLPCI_Enabled ? "true" : "false");
+	jsonConfig += std::string(",\"klass_vcr_enabled\": ") + (options.isKlassVCR_Enabled ? "true" : "false");
+	jsonConfig += std::string(",\"klass_vmmr_enabled\": ") + (options.isKlassVMMR_Enabled ? "true" : "false");
+	jsonConfig += std::string(",\"klass_vbsr_enabled\": ") + (options.isKlassVBSR_Enabled ? "true" : "false");
+	if (!options.licenseTokenFile.empty()) {
+		jsonConfig += std::string(",\"license_token_file\": \"") + options.licenseTokenFile + std::string("\"");
+	}
+	if (!options.licenseTokenData.empty()) {
+		jsonConfig += std::string(",\"license_token_data\": \"") + options.licenseTokenData + std::string("\"");
 	}
 
-	// Create image indices
-	std::vector<size_t> indices(loopCount, 0);
+	jsonConfig += "}"; // end-of-config
+	return jsonConfig;
+}
+
+/*
+* Engine options reported with --report (same names as the command line options)
+*/
+static void benchmarkOptionsColumns(const BenchmarkOptions& options, std::vector<std::pair<std::string, std::string> >& columns)
+{
+	columns = {
+		{ "charset", options.charset }, { "num_threads", options.numThreads },
+		{ "parallel", options.isParallelDeliveryEnabled ? "true" : "false" }, { "rectify", options.isRectificationEnabled ? "true" : "false" },
+		{ "ienv_enabled", options.isIENVEnabled ? "true" : "false" }, { "openvino_enabled", options.isOpenVinoEnabled ? "true" : "false" },
+		{ "openvino_device", options.openvinoDevice }, { "npu_enabled", options.isNpuEnabled ? "true" : "false" },
+		{ "trt_enabled", options.isTensorRTEnabled ? "true" : "false" }, { "simd_enabled", options.isSimdEnabled ? "true" : "false" },
+		{ "klass_lpci_enabled", options.isKlassLPCI_Enabled ? "true" : "false" }, { "klass_vcr_enabled", options.isKlassVCR_Enabled ? "true" : "false" },
+		{ "klass_vmmr_enabled", options.isKlassVMMR_Enabled ? "true" : "false" }, { "klass_vbsr_enabled", options.isKlassVBSR_Enabled ? "true" : "false" },
+		{ "batch_size", std::to_string(options.batchSize) }
+	};
+}
 
-	const int numPositives = static_cast<int>(loopCount * percentPositives);
-	for (int i = 0; i < numPositives; ++i) {
-		indices[i] = 1; // positive index
+/*
+* Decoded images and the order in which they're submitted
+*/
+struct BenchmarkInput {
+	std::vector<const AlprFile*> files; // Index -> file
+	std::vector<size_t> fileGroups; // Index -> group (negative/positive or size bucket)
+	std::vector<std::string> groupNames;
+	std::vector<bool> fileDelivered; // Index -> whether the file has plates, i.e. is expected to be delivered in parallel mode
+	std::vector<size_t> indices; // Submission order
+	bool isCorpus = false;
+};
+
+/*
+* Corpus mode: finds the files with plates, the only ones delivered in parallel mode, so that the missing deliveries
+* are only waited for (and counted as failures) for these files. Each file is processed once with the engine
+* initialized in sequential mode, using "options" otherwise. The engine is deinitialized before returning.
+* @returns false if the engine failed to initialize or process a file, true otherwise.
+*/
+static bool benchmarkClassifyCorpus(const BenchmarkOptions& options, BenchmarkInput& input)
+{
+	BenchmarkOptions sequentialOptions = options;
+	sequentialOptions.isParallelDeliveryEnabled = false;
+	const std::string jsonConfig = benchmarkJsonConfig(sequentialOptions);
+	UltAlprSdkResult result;
+	if (!(result = UltAlprSdkEngine::init(
+		ASSET_MGR_PARAM()
+		jsonConfig.c_str()
+	)).isOK()) {
+		ULTALPR_SDK_PRINT_ERROR("Failed to initialize the engine: %s", result.phrase());
+		return false;
+	}
+	bool ok = true;
+	size_t withPlates = 0;
+	input.fileDelivered.assign(input.files.size(), false);
+	for (size_t i = 0; i < input.files.size() && ok; ++i) {
+		const AlprFile* file = input.files[i];
+		if (!(result = UltAlprSdkEngine::process(file->type, file->uncompressedData, file->width, file->height)).isOK()) {
+			ULTALPR_SDK_PRINT_ERROR("Failed to process frame: %s", result.phrase());
+			ok = false;
+		}
+		else if (result.numPlates()) {
+			input.fileDelivered[i] = true;
+			++withPlates;
+		}
 	}
-	std::shuffle(std::begin(indices), std::end(indices), std::default_random_engine{}); // make the indices random
+	UltAlprSdkEngine::deInit();
+	if (ok) {
+		ULTALPR_SDK_PRINT_INFO("Corpus: %zu of %zu files with plates, the others aren't delivered in parallel mode", withPlates, input.files.size());
+	}
+	return ok;
+}
+
+#define BENCHMARK_DELIVERY_TIMEOUT_MILLIS	1500 // Maximum time to wait for the deliveries, after the warm up or the timed loop (parallel mode)
 
+/*
+* Initializes the engine and warms it up for all the input shapes. In parallel mode, waits until the warm up
+* frames are processed (up to BENCHMARK_DELIVERY_TIMEOUT_MILLIS). The deliveries are reset before returning.
+* @returns false if the engine failed to initialize or warm up, true otherwise.
+*/
+static bool benchmarkInit(const BenchmarkOptions& options, const BenchmarkInput& input, UltAlprSdkParallelDeliveryCallback* parallelDeliveryCallback, UltAlprSdkResult& result)
+{
 	// Init
 	ULTALPR_SDK_PRINT_INFO("Starting benchmark...");
-	ULTALPR_SDK_ASSERT((result = UltAlprSdkEngine::init(
+	const std::string jsonConfig = benchmarkJsonConfig(options);
+	if (!(result = UltAlprSdkEngine::init(
 		ASSET_MGR_PARAM()
 		jsonConfig.c_str(),
-		isParallelDeliveryEnabled ? &parallelDeliveryCallbackCallback : nullptr
-	)).isOK());
+		options.isParallelDeliveryEnabled ? parallelDeliveryCallback : nullptr
+	)).isOK()) {
+		ULTALPR_SDK_PRINT_ERROR("Failed to initialize the engine: %s", result.phrase());
+		return false;
+	}
 
 	// Warm up:
 	// First time the SDK is called we'll be loading the models into CPU or GPU and initializing
 	// some internal variables -> do not include this part in te timing.
 	// The warm up function will make fake inference to force the engine to load the models and init the vars.
-	if (loopCount > 1) {
-		ULTALPR_SDK_ASSERT((result = UltAlprSdkEngine::warmUp(
-			filePositive.type
-		)).isOK());
+	// All resolutions are warmed up so that the first timed frame doesn't pay the per-resolution allocations.
+	if (input.indices.size() > 1) {
+		std::vector<AlprWarmUpShape> shapes;
+		for (const AlprFile* file : input.files) {
+			const bool known = std::find_if(shapes.begin(), shapes.end(), [file](const AlprWarmUpShape& shape) {
+				return shape.type == file->type && shape.width == file->width && shape.height == file->height;
+			}) != shapes.end();
+			if (!known) {
+				shapes.push_back(AlprWarmUpShape());
+				shapes.back().type = file->type;
+				shapes.back().width = file->width;
+				shapes.back().height = file->height;
+			}
+		}
+		std::vector<AlprWarmUpTiming> timings;
+		if (!alprWarmUp(shapes.data(), shapes.size(), timings)) {
+			ULTALPR_SDK_PRINT_ERROR("Failed to warm up the engine");
+			return false;
+		}
+		for (const AlprWarmUpTiming& timing : timings) {
+			ULTALPR_SDK_PRINT_INFO("Warm up %zux%zu: %lf millis (steady: %lf millis)%s", timing.shape.width, timing.shape.height, timing.millis, timing.steadyMillis,
+				options.isParallelDeliveryEnabled ? ", time to queue only (parallel mode)" : "");
+		}
+		// Parallel mode: the blank frames are only queued and, without plate, never delivered. Queue a frame expected
+		// to be delivered after them and wait for its delivery so that the warm up doesn't overlap the timed loop.
+		if (options.isParallelDeliveryEnabled) {
+			size_t drain = 0;
+			for (; drain < input.files.size() && !input.fileDelivered[drain]; ++drain) ;
+			if (drain == input.files.size()) {
+				ULTALPR_SDK_PRINT_INFO("No input frame expected to be delivered: the warm up may overlap the timed loop");
+			}
+			else {
+				const AlprFile* file = input.files[drain];
+				if (!(result = UltAlprSdkEngine::process(file->type, file->uncompressedData, file->width, file->height)).isOK()) {
+					ULTALPR_SDK_PRINT_ERROR("Failed to process frame: %s", result.phrase());
+					return false;
+				}
+				const int64_t frameId = alprJsonFrameId(result.json());
+				const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(BENCHMARK_DELIVERY_TIMEOUT_MILLIS);
+				std::unique_lock<std::mutex > lk(deliveryMutex);
+				parallelNotifCondVar.wait_until(lk, deadline, [frameId] {
+					return frameId < 0 || deliveries.find(frameId) != deliveries.end();
+				});
+			}
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock(deliveryMutex);
+		deliveries.clear();
+	}
+	parallelNotifCount = 0;
+	return true;
+}
+
+/*
+* Waits for the deliveries (parallel mode) then fills "run" (except its config) with the per-frame latencies
+*/
+static void benchmarkCollect(const BenchmarkOptions& options, const BenchmarkInput& input, const std::vector<BenchmarkFrameTiming>& timings, const double elapsedTimeInMillis, BenchmarkRun& run)
+{
+	// Printing to the console is very slow and use a low priority thread.
+	// Wait until all results are displayed: every frame expected to be delivered (the files with plates) has its frame id
+	// in the deliveries. The frames without plate are never delivered.
+	if (options.isParallelDeliveryEnabled) {
+		const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(BENCHMARK_DELIVERY_TIMEOUT_MILLIS);
+		std::unique_lock<std::mutex > lk(deliveryMutex);
+		parallelNotifCondVar.wait_until(lk, deadline, [&input, &timings] {
+			return std::all_of(timings.begin(), timings.end(), [&input](const BenchmarkFrameTiming& timing) {
+				return !input.fileDelivered[timing.file] || deliveries.find(timing.frameId) != deliveries.end();
+			});
+		});
+	}
+
+	// Per-frame latency. Sequential mode: time spent in process(). Parallel mode: from process() to the
+	// delivery callback. The callback is only called for frames with plates: the frames without delivery
+	// have no latency and are left out of the percentiles. They're expected for the files without plate (the
+	// negatives, the corpus files without plate), any other one is counted as undelivered (a failure with --baseline).
+	// In corpus mode, the per-bucket throughput is derived from the time spent in process() which is only
+	// meaningful in sequential mode.
+	std::vector<std::vector<double> > latencies(input.groupNames.size());
+	std::vector<double> busyMillis(input.groupNames.size(), 0.0);
+	size_t undelivered = 0, withoutPlate = 0;
+	{
+		std::lock_guard<std::mutex> lock(deliveryMutex);
+		for (const BenchmarkFrameTiming& timing : timings) {
+			busyMillis[timing.group] += std::chrono::duration<double, std::milli>(timing.returned - timing.submitted).count();
+			std::chrono::high_resolution_clock::time_point end = timing.returned;
+			if (options.isParallelDeliveryEnabled) {
+				const auto it = deliveries.find(timing.frameId);
+				if (timing.frameId < 0 || it == deliveries.end()) {
+					++(input.fileDelivered[timing.file] ? undelivered : withoutPlate);
+					continue;
+				}
+				end = it->second;
+			}
+			latencies[timing.group].push_back(std::chrono::duration<double, std::milli>(end - timing.submitted).count());
+		}
+	}
+	run.groupNames = input.groupNames;
+	run.latencies.clear();
+	run.undelivered = undelivered;
+	for (size_t i = 0; i < input.groupNames.size(); ++i) {
+		run.latencies.push_back(benchmarkLatency(latencies[i]));
+		if (latencies[i].empty()) {
+			continue; // No file in this size bucket or no delivery
+		}
+		const BenchmarkLatency& latency = run.latencies.back();
+		ULTALPR_SDK_PRINT_INFO("Latency (%s, %zu frames): min=%lf, p50=%lf, p90=%lf, p99=%lf, max=%lf millis",
+			input.groupNames[i].c_str(), latency.count, latency.min, latency.p50, latency.p90, latency.p99, latency.max);
+		if (input.isCorpus && !options.isParallelDeliveryEnabled && busyMillis[i] > 0.0) {
+			ULTALPR_SDK_PRINT_INFO("Throughput (%s): %lf fps", input.groupNames[i].c_str(), (latency.count * 1000.0) / busyMillis[i]);
+		}
+	}
+	if (withoutPlate) {
+		ULTALPR_SDK_PRINT_INFO("%zu frame(s) without plate, hence without delivery: not in the latency", withoutPlate);
+	}
+	if (undelivered) {
+		ULTALPR_SDK_PRINT_ERROR("%zu frame(s) without delivery: not in the latency", undelivered);
+	}
+
+	run.frames = timings.size();
+	run.elapsedMillis = elapsedTimeInMillis;
+	run.fps = 1000.f / (elapsedTimeInMillis / (double)timings.size());
+	size_t residentBytes, peakResidentBytes;
+	if (alprMemoryUsage(residentBytes, peakResidentBytes)) {
+		run.residentMb = residentBytes / 1048576.0;
+		run.peakResidentMb = peakResidentBytes / 1048576.0;
+	}
+}
+
+/*
+* Runs init, warm up and the timed loop then fills "run" (except its config).
+* The engine is left initialized: call deInit when done.
+* @returns false if the engine failed to initialize, warm up or process a frame, true otherwise.
+*/
+static bool benchmarkTimedLoop(const BenchmarkOptions& options, const BenchmarkInput& input, UltAlprSdkParallelDeliveryCallback* parallelDeliveryCallback, UltAlprSdkResult& result, BenchmarkRun& run)
+{
+	const std::vector<size_t>& indices = input.indices;
+	if (!benchmarkInit(options, input, parallelDeliveryCallback, result)) {
+		return false;
 	}
 
 	// Recognize/Process
 	const std::chrono::high_resolution_clock::time_point timeStart = std::chrono::high_resolution_clock::now();
-	const AlprFile* files[2] = { &fileNegative, &filePositive };
-	for (const auto& indice : indices) {
-		const AlprFile* file = files[indice];
-		ULTALPR_SDK_ASSERT((result = UltAlprSdkEngine::process(
-			file->type,
-			file->uncompressedData,
-			file->width,
-			file->height
-		)).isOK());
+	std::vector<BenchmarkFrameTiming> timings(indices.size());
+	std::vector<UltAlprSdkResult> queuedResults(options.isParallelDeliveryEnabled ? indices.size() : 0); // Parallel mode only, "frame_id" parsed once the timing is done
+	if (options.batchSize > 1) {
+		std::vector<AlprFrame> frames;
+		for (const AlprFile* file : input.files) {
+			frames.push_back(AlprFrame(*file));
+		}
+		std::vector<AlprFrame> batch;
+		std::vector<UltAlprSdkResult> batchResults;
+		batch.reserve(options.batchSize);
+		for (size_t i = 0; i < indices.size(); i += options.batchSize) {
+			batch.clear();
+			for (size_t j = i; j < indices.size() && j < (i + options.batchSize); ++j) {
+				batch.push_back(frames[indices[j]]);
+			}
+			// The frames are processed one by one but timed as a whole: each one gets the batch's start and end
+			const std::chrono::high_resolution_clock::time_point submitted = std::chrono::high_resolution_clock::now();
+			if (!alprProcessBatch(batch.data(), batch.size(), batchResults)) {
+				ULTALPR_SDK_PRINT_ERROR("Failed to process batch");
+				return false;
+			}
+			const std::chrono::high_resolution_clock::time_point returned = std::chrono::high_resolution_clock::now();
+			for (size_t j = 0; j < batchResults.size(); ++j) {
+				BenchmarkFrameTiming& timing = timings[i + j];
+				timing.file = indices[i + j];
+				timing.group = input.fileGroups[timing.file];
+				timing.submitted = submitted;
+				timing.returned = returned;
+				if (!queuedResults.empty()) {
+					queuedResults[i + j] = std::move(batchResults[j]);
+				}
+			}
+			if (queuedResults.empty()) {
+				result = std::move(batchResults.back());
+			}
+		}
+	}
+	else {
+		for (size_t i = 0; i < indices.size(); ++i) {
+			const AlprFile* file = input.files[indices[i]];
+			BenchmarkFrameTiming& timing = timings[i];
+			timing.file = indices[i];
+			timing.group = input.fileGroups[timing.file];
+			timing.submitted = std::chrono::high_resolution_clock::now();
+			if (!(result = UltAlprSdkEngine::process(
+				file->type,
+				file->uncompressedData,
+				file->width,
+				file->height
+			)).isOK()) {
+				ULTALPR_SDK_PRINT_ERROR("Failed to process frame: %s", result.phrase());
+				return false;
+			}
+			timing.returned = std::chrono::high_resolution_clock::now();
+			if (!queuedResults.empty()) {
+				queuedResults[i] = std::move(result);
+			}
+		}
 	}
 	// Compute the estimated frame rate.
 	// At this step all frames are already processed but the result could be still on the delivery
@@ -339,17 +861,656 @@ int main(int argc, char *argv[])
 	const double elapsedTimeInMillis = std::chrono::duration_cast<std::chrono::duration<double >>(timeEnd - timeStart).count() * 1000.0;
 	ULTALPR_SDK_PRINT_INFO("Elapsed time (ALPR) = [[[ %lf millis ]]]", elapsedTimeInMillis);
 
-	// Printing to the console is very slow and use a low priority thread.
-	// Wait until all results are displayed.
-	if (isParallelDeliveryEnabled) {
-		static std::mutex parallelNotifMutex;
-		std::unique_lock<std::mutex > lk(parallelNotifMutex);
-		parallelNotifCondVar.wait_for(lk, 
-			std::chrono::milliseconds(1500), // maximum number of millis to wait for before giving up, must never wait this long unless your positive image doesn't contain a plate at all
-			[&numPositives] { return (parallelNotifCount == numPositives); }
-		);
+	for (size_t i = 0; i < queuedResults.size(); ++i) {
+		timings[i].frameId = alprJsonFrameId(queuedResults[i].json());
+	}
+	if (!queuedResults.empty()) {
+		result = std::move(queuedResults.back());
+	}
+
+	benchmarkCollect(options, input, timings, elapsedTimeInMillis, run);
+	return true;
+}
+
+#define BENCHMARK_OPEN_LOOP_QUEUE_PER_STREAM	2 // In-flight frames per stream before the oldest is dropped, like a camera ring buffer
+#define BENCHMARK_OPEN_LOOP_MAX_LATE_RATIO	0.01 // A rate is sustainable with no drop and at most 1% late frames
+
+// A rate is sustainable when no frame was dropped and at most BENCHMARK_OPEN_LOOP_MAX_LATE_RATIO frames were late
+static bool benchmarkOpenLoopSustainable(const BenchmarkRun& run)
+{
+	return !run.undelivered && run.late <= (run.frames * BENCHMARK_OPEN_LOOP_MAX_LATE_RATIO);
+}
+
+/*
+* Open loop delivery callback: completion time and status of each frame (the tag is the frame index).
+* Called on the processing thread only, once per frame (dropped frames included).
+*/
+class BenchmarkOpenLoopCallback : public AlprAsyncDeliveryCallback {
+public:
+	BenchmarkOpenLoopCallback(std::vector<std::chrono::high_resolution_clock::time_point>& completed, std::vector<uint8_t>& dropped)
+		: completed_(completed), dropped_(dropped) { }
+	virtual void onNewResult(const uint64_t tag, const UltAlprSdkResult& newResult) const override {
+		completed_[tag] = std::chrono::high_resolution_clock::now();
+		dropped_[tag] = (newResult.code() == ALPR_ASYNC_RESULT_CODE_DROPPED) ? 1 : 0;
+	}
+private:
+	std::vector<std::chrono::high_resolution_clock::time_point>& completed_;
+	std::vector<uint8_t>& dropped_;
+};
+
+/*
+* Open loop: each stream submits its frames on a fixed schedule, like a camera, whether or not the engine keeps up.
+* The streams are staggered within the frame period and share an AlprAsyncProcessor (the engine is initialized in
+* sequential mode: the parallel mode only delivers the frames with plates) bounded to BENCHMARK_OPEN_LOOP_QUEUE_PER_STREAM
+* frames per stream, the oldest being dropped when full. The latency goes from the scheduled capture time to the
+* delivery and includes the queue wait. A frame is late when its latency exceeds the latency bound or, without bound,
+* the stream's frame period (it's not done when the next one arrives).
+* @param targetFps Frame rates per stream to run, one run per rate. The engine is initialized once.
+* @returns false if the engine failed to initialize, true otherwise.
+*/
+static bool benchmarkOpenLoop(const BenchmarkOptions& options, const BenchmarkInput& input, const std::vector<double>& targetFps, const size_t streams,
+	const double latencyBoundMillis, UltAlprSdkResult& result, std::vector<BenchmarkRun>& runs)
+{
+	BenchmarkOptions sequentialOptions = options;
+	sequentialOptions.isParallelDeliveryEnabled = false;
+	if (!benchmarkInit(sequentialOptions, input, nullptr, result)) {
+		return false;
+	}
+	std::vector<AlprFrame> frames;
+	for (const AlprFile* file : input.files) {
+		frames.push_back(AlprFrame(*file));
+	}
+	const size_t framesPerStream = (input.indices.size() + streams - 1) / streams;
+	const size_t count = framesPerStream * streams;
+	for (const double fps : targetFps) {
+		std::vector<std::chrono::high_resolution_clock::time_point> scheduled(count), completed(count);
+		std::vector<uint8_t> dropped(count, 0);
+		const BenchmarkOpenLoopCallback callback(completed, dropped);
+		AlprAsyncProcessor processor(&callback);
+		processor.setBackpressure(streams * BENCHMARK_OPEN_LOOP_QUEUE_PER_STREAM, ALPR_DROP_POLICY_DROP_OLDEST);
+
+		const std::chrono::duration<double> period(1.0 / fps);
+		const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now() + std::chrono::milliseconds(10);
+		std::vector<std::thread> producers;
+		for (size_t s = 0; s < streams; ++s) {
+			producers.emplace_back([&, s] {
+				for (size_t k = 0; k < framesPerStream; ++k) {
+					const size_t i = (s * framesPerStream) + k;
+					scheduled[i] = start + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(period * (k + (static_cast<double>(s) / streams)));
+					std::this_thread::sleep_until(scheduled[i]);
+					processor.processAsync(frames[input.indices[i % input.indices.size()]], i);
+				}
+			});
+		}
+		for (std::thread& producer : producers) {
+			producer.join();
+		}
+		processor.stop(); // Drains the queue
+
+		// Latency of the processed frames, from the scheduled capture time
+		BenchmarkRun run;
+		run.undelivered = static_cast<size_t>(processor.dropped());
+		std::vector<double> latencies;
+		std::chrono::high_resolution_clock::time_point end = start;
+		const double lateMillis = (latencyBoundMillis >= 0.0) ? latencyBoundMillis : (period.count() * 1000.0);
+		for (size_t i = 0; i < count; ++i) {
+			if (dropped[i]) {
+				continue;
+			}
+			const double millis = std::chrono::duration<double, std::milli>(completed[i] - scheduled[i]).count();
+			run.late += (millis > lateMillis) ? 1 : 0;
+			latencies.push_back(millis);
+			end = ULTAPR_MAX(end, completed[i]);
+		}
+		run.groupNames = { "open_loop" };
+		run.latencies = { benchmarkLatency(latencies) };
+		run.frames = count;
+		run.elapsedMillis = std::chrono::duration<double, std::milli>(end - start).count();
+		run.fps = (run.elapsedMillis > 0.0) ? (latencies.size() * 1000.0) / run.elapsedMillis : 0.0;
+		size_t residentBytes, peakResidentBytes;
+		if (alprMemoryUsage(residentBytes, peakResidentBytes)) {
+			run.residentMb = residentBytes / 1048576.0;
+			run.peakResidentMb = peakResidentBytes / 1048576.0;
+		}
+		const BenchmarkLatency& latency = run.latencies.back();
+		const bool sustainable = benchmarkOpenLoopSustainable(run);
+		ULTALPR_SDK_PRINT_INFO("Open loop (%zu streams x %lf fps = %lf fps): %zu frames, %zu dropped, %zu late (> %lf millis), achieved %lf fps, "
+			"latency p50=%lf, p90=%lf, p99=%lf, max=%lf millis -> %s",
+			streams, fps, fps * streams, count, run.undelivered, run.late, lateMillis, run.fps,
+			latency.p50, latency.p90, latency.p99, latency.max, sustainable ? "sustainable" : "NOT sustainable");
+		runs.push_back(run);
+	}
+	return true;
+}
+
+/*
+* Worst p99 latency across the groups with frames, used to select the configuration under --latency_bound
+*/
+static double benchmarkWorstP99(const BenchmarkRun& run)
+{
+	double worst = 0.0;
+	for (const BenchmarkLatency& latency : run.latencies) {
+		if (latency.count) {
+			worst = ULTAPR_MAX(worst, latency.p99);
+		}
+	}
+	return worst;
+}
+
+#define BENCHMARK_PRODUCERS_MIN_GAIN	1.05 // One more producer helps when the throughput improves by at least 5%
+
+/*
+* Concurrency scaling: N producer threads (e.g. one per camera) call process() at the same time, for N = 1..maxProducers,
+* in sequential then parallel delivery mode (one init per mode). The frames are split between the producers, each
+* submitting back to back. The throughput is the total number of frames over the wall time: if it doesn't improve with
+* the number of producers, process() serializes the calls internally and more producers only add latency.
+* @param points Delivery mode (parallel) and number of producers for each run.
+* @returns false if the engine failed to initialize or process a frame, true otherwise.
+*/
+static bool benchmarkProducers(const BenchmarkOptions& options, const BenchmarkInput& input, const size_t maxProducers, UltAlprSdkParallelDeliveryCallback* parallelDeliveryCallback,
+	UltAlprSdkResult& result, std::vector<BenchmarkRun>& runs, std::vector<std::pair<bool, size_t> >& points)
+{
+	const std::vector<size_t>& indices = input.indices;
+	for (const bool parallel : { false, true }) {
+		BenchmarkOptions modeOptions = options;
+		modeOptions.isParallelDeliveryEnabled = parallel;
+		if (!benchmarkInit(modeOptions, input, parallelDeliveryCallback, result)) {
+			return false;
+		}
+		const char* mode = parallel ? "parallel" : "sequential";
+		std::vector<double> fps;
+		for (size_t producers = 1; producers <= maxProducers; ++producers) {
+			parallelNotifCount = 0;
+			{
+				std::lock_guard<std::mutex> lock(deliveryMutex);
+				deliveries.clear();
+			}
+			std::vector<BenchmarkFrameTiming> timings(indices.size());
+			std::vector<UltAlprSdkResult> queuedResults(parallel ? indices.size() : 0); // "frame_id" parsed once the timing is done
+			std::atomic<bool> failed(false);
+			std::vector<std::thread> threads;
+			const std::chrono::high_resolution_clock::time_point timeStart = std::chrono::high_resolution_clock::now();
+			for (size_t t = 0; t < producers; ++t) {
+				threads.emplace_back([&, t] {
+					for (size_t i = t; i < indices.size() && !failed; i += producers) {
+						const AlprFile* file = input.files[indices[i]];
+						BenchmarkFrameTiming& timing = timings[i];
+						timing.file = indices[i];
+						timing.group = input.fileGroups[timing.file];
+						timing.submitted = std::chrono::high_resolution_clock::now();
+						UltAlprSdkResult frameResult = UltAlprSdkEngine::process(file->type, file->uncompressedData, file->width, file->height);
+						timing.returned = std::chrono::high_resolution_clock::now();
+						if (!frameResult.isOK()) {
+							ULTALPR_SDK_PRINT_ERROR("Failed to process frame: %s", frameResult.phrase());
+							failed = true;
+						}
+						if (parallel) {
+							queuedResults[i] = std::move(frameResult);
+						}
+					}
+				});
+			}
+			for (std::thread& thread : threads) {
+				thread.join();
+			}
+			const double elapsedTimeInMillis = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - timeStart).count();
+			if (failed) {
+				UltAlprSdkEngine::deInit();
+				return false;
+			}
+			for (size_t i = 0; i < queuedResults.size(); ++i) {
+				timings[i].frameId = alprJsonFrameId(queuedResults[i].json());
+			}
+			BenchmarkRun run;
+			benchmarkCollect(modeOptions, input, timings, elapsedTimeInMillis, run);
+			fps.push_back(run.fps);
+			ULTALPR_SDK_PRINT_INFO("Producers (%s, %zu): %lf fps (x%.2lf versus 1 producer), p99=%lf millis",
+				mode, producers, run.fps, run.fps / fps.front(), benchmarkWorstP99(run));
+			runs.push_back(run);
+			points.push_back(std::make_pair(parallel, producers));
+		}
+		UltAlprSdkEngine::deInit();
+
+		// Where adding producers stops helping
+		size_t best = 0;
+		while (best + 1 < fps.size() && fps[best + 1] >= fps[best] * BENCHMARK_PRODUCERS_MIN_GAIN) {
+			++best;
+		}
+		ULTALPR_SDK_PRINT_INFO("*** Producers (%s): scaling stops at %zu producer(s), %lf fps (x%.2lf)%s ***",
+			mode, best + 1, fps[best], fps[best] / fps.front(),
+			(fps.size() > 1 && best == 0) ? ": process() serializes the calls" : "");
+	}
+	return true;
+}
+
+/*
+* Parses a --sweep grid: "option=value1,value2;option=value1,...". Each point is a set of options (with "--").
+* @returns false if the grid is invalid, true otherwise.
+*/
+static bool benchmarkParseSweep(const std::string& grid, std::vector<std::map<std::string, std::string> >& points)
+{
+	points.assign(1, std::map<std::string, std::string>());
+	size_t begin = 0;
+	while (begin < grid.size()) {
+		size_t end = grid.find(';', begin);
+		end = (end == std::string::npos) ? grid.size() : end;
+		const std::string axis = grid.substr(begin, end - begin);
+		begin = end + 1;
+		if (axis.empty()) {
+			continue;
+		}
+		const size_t equal = axis.find('=');
+		const std::string name = axis.substr(0, equal);
+		if (equal == std::string::npos || std::find_if(std::begin(benchmarkSweepOptions), std::end(benchmarkSweepOptions),
+			[&name](const char* option) { return name == option; }) == std::end(benchmarkSweepOptions)) {
+			ULTALPR_SDK_PRINT_ERROR("Invalid sweep axis: %s", axis.c_str());
+			return false;
+		}
+		std::vector<std::string> values;
+		for (size_t v = equal + 1; v <= axis.size(); ) {
+			size_t comma = axis.find(',', v);
+			comma = (comma == std::string::npos) ? axis.size() : comma;
+			if (comma > v) {
+				values.push_back(axis.substr(v, comma - v));
+			}
+			v = comma + 1;
+		}
+		if (values.empty()) {
+			ULTALPR_SDK_PRINT_ERROR("No value for sweep axis: %s", name.c_str());
+			return false;
+		}
+		// Cartesian product
+		std::vector<std::map<std::string, std::string> > product;
+		for (const std::map<std::string, std::string>& point : points) {
+			for (const std::string& value : values) {
+				product.push_back(point);
+				product.back()["--" + name] = value;
+			}
+		}
+		points.swap(product);
+	}
+	return true;
+}
+
+/*
+* Entry point
+*/
+int main(int argc, char *argv[])
+{
+	// local variables
+	UltAlprSdkResult result;
+	MyUltAlprSdkParallelDeliveryCallback parallelDeliveryCallbackCallback;
+	BenchmarkOptions options;
+	size_t loopCount = 100;
+	double percentPositives = .2; // 20%
+	std::string pathFilePositive;
+	std::string pathFileNegative;
+	std::string pathCorpus;
+	bool isCorpusOrderRandom = true;
+	std::string reportFormat; // json, csv or empty (none)
+	std::string pathReportFile;
+	std::string pathBaseline;
+	double maxRegressionPercent = 5.0;
+	std::vector<std::map<std::string, std::string> > sweepPoints; // Options for each point of the grid
+	double latencyBoundMillis = -1.0; // Negative means no bound
+	std::vector<double> targetFps; // Open loop when not empty
+	size_t streams = 1;
+	size_t maxProducers = 0; // Concurrency scaling when not zero
+
+	// Parsing args
+	std::map<std::string, std::string > args;
+	if (!alprParseArgs(argc, argv, args)) {
+		printUsage();
+		return -1;
+	}
+	if (args.find("--corpus") != args.end()) {
+		pathCorpus = args["--corpus"];
+	}
+	if (args.find("--order") != args.end()) {
+		if (args["--order"].compare("random") && args["--order"].compare("fixed")) {
+			printUsage("--order must be random or fixed");
+			return -1;
+		}
+		isCorpusOrderRandom = (args["--order"].compare("random") == 0);
+	}
+	if (args.find("--report") != args.end()) {
+		reportFormat = args["--report"];
+		if (reportFormat.compare("json") && reportFormat.compare("csv")) {
+			printUsage("--report must be json or csv");
+			return -1;
+		}
+	}
+	if (args.find("--report_file") != args.end()) {
+		pathReportFile = args["--report_file"];
+	}
+	if (args.find("--baseline") != args.end()) {
+		pathBaseline = args["--baseline"];
+	}
+	if (args.find("--max_regression") != args.end()) {
+		maxRegressionPercent = std::atof(args["--max_regression"].c_str());
+		if (maxRegressionPercent < 0.0) {
+			printUsage("--max_regression must be within [0.0, inf]");
+			return -1;
+		}
+	}
+	if (args.find("--sweep") != args.end()) {
+		if (!benchmarkParseSweep(args["--sweep"], sweepPoints)) {
+			printUsage("Invalid --sweep grid");
+			return -1;
+		}
+		if (!pathBaseline.empty()) {
+			printUsage("--baseline cannot be used with --sweep");
+			return -1;
+		}
+	}
+	if (args.find("--latency_bound") != args.end()) {
+		latencyBoundMillis = std::atof(args["--latency_bound"].c_str());
+	}
+	if (args.find("--target_fps") != args.end()) {
+		const std::string& rates = args["--target_fps"];
+		for (size_t begin = 0; begin < rates.size(); ) {
+			size_t end = rates.find(',', begin);
+			end = (end == std::string::npos) ? rates.size() : end;
+			const double fps = std::atof(rates.substr(begin, end - begin).c_str());
+			if (fps <= 0.0) {
+				printUsage("--target_fps must be within ]0.0, inf]");
+				return -1;
+			}
+			targetFps.push_back(fps);
+			begin = end + 1;
+		}
+		if (!sweepPoints.empty() || !pathBaseline.empty()) {
+			printUsage("--target_fps cannot be used with --sweep or --baseline");
+			return -1;
+		}
+	}
+	if (args.find("--producers") != args.end()) {
+		const int count = (args["--producers"] == "cores")
+			? static_cast<int>(std::thread::hardware_concurrency())
+			: std::atoi(args["--producers"].c_str());
+		if (count < 1) {
+			printUsage("--producers must be within [1, inf] or cores");
+			return -1;
+		}
+		if (!sweepPoints.empty() || !targetFps.empty() || !pathBaseline.empty()) {
+			printUsage("--producers cannot be used with --sweep, --target_fps or --baseline");
+			return -1;
+		}
+		maxProducers = static_cast<size_t>(count);
+	}
+	if (args.find("--streams") != args.end()) {
+		const int count = std::atoi(args["--streams"].c_str());
+		if (count < 1) {
+			printUsage("--streams must be within [1, inf]");
+			return -1;
+		}
+		streams = static_cast<size_t>(count);
+	}
+	if (pathCorpus.empty()) {
+		if (args.find("--positive") == args.end()) {
+			printUsage("--positive required");
+			return -1;
+		}
+		if (args.find("--negative") == args.end()) {
+			printUsage("--negative required");
+			return -1;
+		}
+		pathFilePositive = args["--positive"];
+		pathFileNegative = args["--negative"];
+	}
+	if (args.find("--rate") != args.end()) {
+		const double rate = std::atof(args["--rate"].c_str());
+		if (rate > 1.0 || rate < 0.0) {
+			printUsage("--rate must be within [0.0, 1.0]");
+			return -1;
+		}
+		percentPositives = rate;
+	}
+	if (args.find("--loops") != args.end()) {
+		const int loops = std::atoi(args["--loops"].c_str());
+		if (loops < 1) {
+			printUsage("--loops must be within [1, inf]");
+			return -1;
+		}
+		loopCount = static_cast<size_t>(loops);
+	}
+	if (!benchmarkParseOptions(args, options)) {
+		return -1;
 	}
 
+	// Read files
+	// Positive: the file contains at least one plate
+	// Negative: the file doesn't contain a plate
+	// Change positive rates to evaluate the detector versus recognizer
+	// Corpus mode: all files from the folder are decoded here, before the timing starts
+	BenchmarkInput input;
+	std::vector<AlprFile> corpus; // Never resized after decoding: AlprFile owns its pixels and must not be copied
+	AlprFile filePositive, fileNegative;
+	if (!pathCorpus.empty()) {
+		std::vector<std::string> paths;
+		if (!alprListImageFiles(pathCorpus, paths)) {
+			return -1;
+		}
+		if (paths.empty()) {
+			ULTALPR_SDK_PRINT_INFO("No JPEG/PNG/BMP file in corpus folder: %s", pathCorpus.c_str());
+			return -1;
+		}
+		corpus.resize(paths.size());
+		for (size_t i = 0; i < paths.size(); ++i) {
+			if (!alprDecodeFile(paths[i], corpus[i])) {
+				ULTALPR_SDK_PRINT_INFO("Failed to read corpus file: %s", paths[i].c_str());
+				return -1;
+			}
+			input.files.push_back(&corpus[i]);
+			input.fileGroups.push_back(benchmarkSizeBucket(corpus[i].width, corpus[i].height));
+		}
+		input.groupNames.assign(std::begin(benchmarkSizeBucketNames), std::end(benchmarkSizeBucketNames));
+		input.fileDelivered.assign(input.files.size(), true);
+		input.isCorpus = true;
+		ULTALPR_SDK_PRINT_INFO("Corpus: %zu files decoded from %s", corpus.size(), pathCorpus.c_str());
+		// Parallel mode only delivers the frames with plates: find them before timing anything
+		const bool anyParallel = options.isParallelDeliveryEnabled || maxProducers
+			|| std::any_of(sweepPoints.begin(), sweepPoints.end(), [](const std::map<std::string, std::string>& point) {
+				const auto it = point.find("--parallel");
+				return it != point.end() && it->second == "true";
+			});
+		if (anyParallel && !benchmarkClassifyCorpus(options, input)) {
+			return -1;
+		}
+	}
+	else {
+		if (!alprDecodeFile(pathFilePositive, filePositive)) {
+			ULTALPR_SDK_PRINT_INFO("Failed to read positive file: %s", pathFilePositive.c_str());
+			return -1;
+		}
+		if (!alprDecodeFile(pathFileNegative, fileNegative)) {
+			ULTALPR_SDK_PRINT_INFO("Failed to read positive file: %s", pathFilePositive.c_str());
+			return -1;
+		}
+		input.files = { &fileNegative, &filePositive };
+		input.fileGroups = { 0, 1 };
+		input.groupNames = { "negative", "positive" };
+		input.fileDelivered = { false, true };
+	}
+
+	// Create image indices
+	std::vector<size_t>& indices = input.indices;
+	indices.assign(loopCount, 0);
+	if (input.isCorpus) {
+		// Each pass goes through the whole corpus once: in name order (fixed) or shuffled (random), so that
+		// fewer loops than files still sample the whole corpus in random order
+		std::vector<size_t> order(input.files.size());
+		for (size_t i = 0; i < order.size(); ++i) {
+			order[i] = i;
+		}
+		std::default_random_engine engine;
+		for (size_t i = 0; i < indices.size(); ++i) {
+			if (isCorpusOrderRandom && (i % order.size()) == 0) {
+				std::shuffle(std::begin(order), std::end(order), engine);
+			}
+			indices[i] = order[i % order.size()];
+		}
+		if (!isCorpusOrderRandom && indices.size() < order.size()) {
+			ULTALPR_SDK_PRINT_INFO("Only the first %zu of the %zu corpus files (name order) are used, increase --loops or use --order random",
+				indices.size(), order.size());
+		}
+	}
+	else {
+		const size_t numPositives = static_cast<size_t>(loopCount * percentPositives);
+		for (size_t i = 0; i < numPositives; ++i) {
+			indices[i] = 1; // positive index
+		}
+		std::shuffle(std::begin(indices), std::end(indices), std::default_random_engine{}); // make the indices random
+	}
+
+	// Options reported with --report, in addition to the engine options
+	const auto reportConfig = [&](const BenchmarkOptions& runOptions, BenchmarkRun& run) {
+		benchmarkOptionsColumns(runOptions, run.config);
+		run.config.push_back(std::make_pair("loops", std::to_string(loopCount)));
+		run.config.push_back(std::make_pair("rate", pathCorpus.empty() ? benchmarkNumber(percentPositives) : ""));
+		run.config.push_back(std::make_pair("corpus", pathCorpus));
+		run.config.push_back(std::make_pair("order", pathCorpus.empty() ? "" : (isCorpusOrderRandom ? "random" : "fixed")));
+	};
+	const auto writeReport = [&](const std::string& report) {
+		FILE* file = pathReportFile.empty() ? stdout : fopen(pathReportFile.c_str(), "wb");
+		if (!file) {
+			ULTALPR_SDK_PRINT_ERROR("Failed to open report file at: %s", pathReportFile.c_str());
+			return;
+		}
+		fwrite(report.data(), 1, report.size(), file);
+		if (file != stdout) {
+			fclose(file);
+		}
+	};
+
+	// Several runs (sweep, open loop rates): JSON array or CSV matrix (default)
+	const auto writeRuns = [&](const std::vector<BenchmarkRun>& runs) {
+		std::string report;
+		for (size_t i = 0; i < runs.size(); ++i) {
+			if (reportFormat == "json") {
+				report += i ? "," : "[";
+				benchmarkReportJson(runs[i], report);
+				report.pop_back(); // "\n"
+			}
+			else {
+				benchmarkReportCsv(runs[i], (i == 0), report);
+			}
+		}
+		if (reportFormat == "json") {
+			report += "]\n";
+		}
+		writeReport(report);
+	};
+
+	// Open loop: fixed-rate submission for each target rate, in one invocation
+	if (!targetFps.empty()) {
+		std::vector<BenchmarkRun> runs;
+		const bool ok = benchmarkOpenLoop(options, input, targetFps, streams, latencyBoundMillis, result, runs);
+		UltAlprSdkEngine::deInit();
+		if (!ok) {
+			return -1;
+		}
+		size_t best = runs.size();
+		for (size_t i = 0; i < runs.size(); ++i) {
+			BenchmarkOptions sequentialOptions = options;
+			sequentialOptions.isParallelDeliveryEnabled = false;
+			reportConfig(sequentialOptions, runs[i]);
+			runs[i].config.push_back(std::make_pair("target_fps", benchmarkNumber(targetFps[i])));
+			runs[i].config.push_back(std::make_pair("streams", std::to_string(streams)));
+			if (benchmarkOpenLoopSustainable(runs[i]) && (best == runs.size() || targetFps[i] > targetFps[best])) {
+				best = i;
+			}
+		}
+		if (best < runs.size()) {
+			ULTALPR_SDK_PRINT_INFO("*** Highest sustainable rate: %lf fps per stream, %lf fps total (%zu streams) ***",
+				targetFps[best], targetFps[best] * streams, streams);
+		}
+		else {
+			ULTALPR_SDK_PRINT_INFO("*** No sustainable rate, try lower --target_fps values ***");
+		}
+		writeRuns(runs);
+		return 0;
+	}
+
+	// Concurrency scaling: 1..N producer threads calling process() at the same time, sequential then parallel mode
+	if (maxProducers) {
+		std::vector<BenchmarkRun> runs;
+		std::vector<std::pair<bool, size_t> > points;
+		if (!benchmarkProducers(options, input, maxProducers, &parallelDeliveryCallbackCallback, result, runs, points)) {
+			return -1;
+		}
+		for (size_t i = 0; i < runs.size(); ++i) {
+			BenchmarkOptions modeOptions = options;
+			modeOptions.isParallelDeliveryEnabled = points[i].first;
+			reportConfig(modeOptions, runs[i]);
+			runs[i].config.push_back(std::make_pair("producers", std::to_string(points[i].second)));
+		}
+		writeRuns(runs);
+		return 0;
+	}
+
+	// Sweep: init, warm up and timed loop for each point of the grid, in one invocation
+	if (!sweepPoints.empty()) {
+		const std::vector<std::map<std::string, std::string> >& points = sweepPoints;
+		std::vector<BenchmarkRun> runs;
+		std::vector<std::string> labels;
+		for (size_t i = 0; i < points.size(); ++i) {
+			std::map<std::string, std::string> pointArgs = args;
+			std::string label;
+			for (const std::pair<const std::string, std::string>& option : points[i]) {
+				pointArgs[option.first] = option.second;
+				label += (label.empty() ? "" : " ") + option.first + " " + option.second;
+			}
+			BenchmarkOptions pointOptions = options;
+			if (!benchmarkParseOptions(pointArgs, pointOptions)) {
+				return -1;
+			}
+			ULTALPR_SDK_PRINT_INFO("Sweep %zu/%zu: %s", i + 1, points.size(), label.c_str());
+			BenchmarkRun run;
+			const bool ok = benchmarkTimedLoop(pointOptions, input, &parallelDeliveryCallbackCallback, result, run);
+			UltAlprSdkEngine::deInit();
+			if (!ok) {
+				ULTALPR_SDK_PRINT_ERROR("Sweep %zu/%zu failed, skipped: %s", i + 1, points.size(), label.c_str());
+				continue;
+			}
+			reportConfig(pointOptions, run);
+			runs.push_back(run);
+			labels.push_back(label);
+		}
+		if (runs.empty()) {
+			ULTALPR_SDK_PRINT_ERROR("All sweep points failed");
+			return -1;
+		}
+
+		// Result matrix, one line per point
+		size_t best = runs.size();
+		for (size_t i = 0; i < runs.size(); ++i) {
+			const double p99 = benchmarkWorstP99(runs[i]);
+			ULTALPR_SDK_PRINT_INFO("Sweep result [%s]: fps=%lf, p99=%lf millis, peak_resident_mb=%lf",
+				labels[i].c_str(), runs[i].fps, p99, runs[i].peakResidentMb);
+			if ((latencyBoundMillis < 0.0 || p99 <= latencyBoundMillis) && (best == runs.size() || runs[i].fps > runs[best].fps)) {
+				best = i;
+			}
+		}
+		if (best < runs.size()) {
+			ULTALPR_SDK_PRINT_INFO("*** Recommended configuration: [%s] (fps=%lf, p99=%lf millis) ***",
+				labels[best].c_str(), runs[best].fps, benchmarkWorstP99(runs[best]));
+		}
+		else {
+			ULTALPR_SDK_PRINT_INFO("*** No configuration meets the latency bound (%lf millis) ***", latencyBoundMillis);
+		}
+		writeRuns(runs);
+		return 0;
+	}
+
+	// Timed loop
+	BenchmarkRun run;
+	if (!benchmarkTimedLoop(options, input, &parallelDeliveryCallbackCallback, result, run)) {
+		UltAlprSdkEngine::deInit();
+		return -1;
+	}
+	reportConfig(options, run);
+
 	// Print latest result
 	const std::string& json_ = result.json();
 	if (!json_.empty()) {
@@ -357,17 +1518,32 @@ int main(int argc, char *argv[])
 	}
 
 	// Print estimated frame rate
-	const double estimatedFps = 1000.f / (elapsedTimeInMillis / (double)loopCount);
-	ULTALPR_SDK_PRINT_INFO("*** elapsedTimeInMillis: %lf, estimatedFps: %lf ***", elapsedTimeInMillis, estimatedFps);
+	ULTALPR_SDK_PRINT_INFO("*** elapsedTimeInMillis: %lf, estimatedFps: %lf ***", run.elapsedMillis, run.fps);
 
-	ULTALPR_SDK_PRINT_INFO("Press any key to terminate !!");
-	getchar();
+	// Machine-readable report and regression gate
+	if (!reportFormat.empty()) {
+		std::string report;
+		if (reportFormat == "json") {
+			benchmarkReportJson(run, report);
+		}
+		else {
+			benchmarkReportCsv(run, true, report);
+		}
+		writeReport(report);
+	}
+	const bool baselinePassed = pathBaseline.empty() || benchmarkCheckBaseline(pathBaseline, run, maxRegressionPercent);
+
+	// Unattended runs (report or baseline) don't wait for a key
+	if (reportFormat.empty() && pathBaseline.empty()) {
+		ULTALPR_SDK_PRINT_INFO("Press any key to terminate !!");
+		getchar();
+	}
 
 	// DeInit
 	ULTALPR_SDK_PRINT_INFO("Ending benchmark...");
 	ULTALPR_SDK_ASSERT((result = UltAlprSdkEngine::deInit()).isOK());
 
-	return 0;
+	return baselinePassed ? 0 : 1;
 }
 
 /*
@@ -384,6 +1560,17 @@ static void printUsage(const std::string& message /*= ""*/)
 		"benchmark\n"
 		"\t--positive <path-to-image-with-a-plate> \n"
 		"\t--negative <path-to-image-without-a-plate> \n"
+		"\t[--corpus <path-to-folder-with-images>] \n"
+		"\t[--order <corpus-replay-order:random/fixed>] \n"
+		"\t[--report <report-format:json/csv>] \n"
+		"\t[--report_file <path-to-report-file>] \n"
+		"\t[--baseline <path-to-json-report-from-a-previous-run>] \n"
+		"\t[--max_regression <max-regression-in-percent:[0.0, inf]>] \n"
+		"\t[--sweep <parameter-grid:option=value,value;option=value...>] \n"
+		"\t[--latency_bound <max-p99-latency-in-millis>] \n"
+		"\t[--target_fps <frame-rates-per-stream:fps,fps...>] \n"
+		"\t[--streams <number-of-streams:[1, inf]>] \n"
+		"\t[--producers <max-number-of-producer-threads:[1, inf]/cores>] \n"
 		"\t[--assets <path-to-assets-folder>] \n"
 		"\t[--charset <recognition-charset:latin/korean/chinese>] \n"
 		"\t[--num_threads <number of threads : [1, inf]>] \n"
@@ -398,6 +1585,7 @@ static void printUsage(const std::string& message /*= ""*/)
 		"\t[--klass_vmmr_enabled <whether-to-enable-VMMR:true/false>] \n"
 		"\t[--klass_vbsr_enabled <whether-to-enable-VBSR:true/false>] \n"
 		"\t[--loops <number-of-times-to-run-the-loop:[1, inf]>] \n"
+		"\t[--batch_size <number-of-frames-per-batch:[1, inf]>] \n"
 		"\t[--rate <positive-rate:[0.0, 1.0]>] \n"
 		"\t[--parallel <whether-to-enable-parallel-mode:true / false>] \n"
 		"\t[--rectify <whether-to-enable-rectification-layer:true / false>]\n"
@@ -408,6 +1596,17 @@ static void printUsage(const std::string& message /*= ""*/)
 		"\n"
 		"--positive: Path to an image(JPEG/PNG/BMP) with a license plate. This image will be used to evaluate the recognizer. You can use default image at ../../../assets/images/lic_us_1280x720.jpg.\n\n"
 		"--negative: Path to an image(JPEG/PNG/BMP) without a license plate. This image will be used to evaluate the detector. You can use default image at ../../../assets/images/london_traffic.jpg.\n\n"
+		"--corpus: Path to a folder with JPEG/PNG/BMP images. All images are decoded before the timing starts and replayed --loops times in total. --positive, --negative and --rate are not required (ignored) when this option is defined. The latency (and, in sequential mode, the throughput) is reported per image size bucket. In parallel mode, each file is processed once in sequential mode first to find the files with plates (the only ones delivered). Default: null.\n\n"
+		"--order: Order used to replay the corpus images: random (shuffled with a fixed seed) or fixed (sorted by file name). Each pass goes through the whole corpus: with fewer loops than files, fixed only uses the first files by name. Default: random.\n\n"
+		"--report: Writes a machine-readable report (json or csv) with the configuration, host CPU, throughput, latency percentiles and memory usage. Default: null.\n\n"
+		"--report_file: Path to the file where to write the report. Default: standard output.\n\n"
+		"--baseline: Path to a JSON report from a previous run (--report json). The application exits with code 1 if the throughput or the p50/p90/p99 latency regressed by more than --max_regression, or if frames with plates (positives, corpus files with plates) weren't delivered (parallel mode). Default: null.\n\n"
+		"--max_regression: Maximum regression (percent) allowed versus --baseline. Default: 5.0.\n\n"
+		"--sweep: Parameter grid, e.g. \"num_threads=2,4,8;parallel=true,false;klass_vcr_enabled=true,false\". Init, warm up and the timed loop are run for each combination, the other options are used as is. Accepted options: num_threads, parallel, rectify, ienv_enabled, openvino_enabled, openvino_device, npu_enabled, trt_enabled, simd_enabled, klass_lpci_enabled, klass_vcr_enabled, klass_vmmr_enabled, klass_vbsr_enabled and charset. The result matrix is written using --report (default: csv) and the fastest configuration is recommended. Default: null.\n\n"
+		"--latency_bound: Maximum p99 latency (millis, worst group) for a --sweep configuration to be recommended. Maximum latency for a frame to be on time with --target_fps. Default: no bound.\n\n"
+		"--target_fps: Open loop mode. Comma-separated frame rates per stream, e.g. 10,15,20,25. For each rate, every stream submits its frames on a fixed schedule whether or not the engine keeps up. The frames are queued (up to 2 per stream, the oldest is dropped when full) in front of the engine, initialized in sequential mode. Reports the end-to-end latency (queue wait included), the dropped and late frames, and the highest sustainable rate. Late means the latency is above --latency_bound or, without bound, above the frame period. Default: null.\n\n"
+		"--streams: Number of streams (cameras) for the open loop mode. The --loops frames are split between the streams. Default: 1.\n\n"
+		"--producers: Concurrency scaling mode. N threads call process() at the same time, for N = 1 to this value (use cores for the number of CPU cores), in sequential then parallel mode. The --loops frames are split between the threads. Reports the throughput and latency for each N and where adding producers stops helping. Default: null.\n\n"
 		"--assets: Path to the assets folder containing the configuration files and models. Default value is the current folder.\n\n"
 		"--charset: Defines the recognition charset value (latin, korean, chinese...). Default: latin.\n\n"
 		"--num_threads: Number of threads to use. More info at https://www.doubango.org/SDKs/anpr/docs/Configuration_options.html#num-threads. Default: -1.\n\n"
@@ -422,6 +1621,7 @@ static void printUsage(const std::string& message /*= ""*/)
 		"--klass_vmmr_enabled: Whether to enable Vehicle Make Model Recognition (VMMR). More info at https://www.doubango.org/SDKs/anpr/docs/Features.html#vehicle-make-model-recognition-vmmr. Default: false.\n\n"
 		"--klass_vbsr_enabled: Whether to enable Vehicle Body Style Recognition (VBSR). More info at https://www.doubango.org/SDKs/anpr/docs/Features.html#vehicle-make-model-recognition-vbsr. Default: false.\n\n"
 		"--loops: Number of times to run the processing pipeline.\n\n"
+		"--batch_size: Number of frames per call to alprProcessBatch(), a convenience loop over process(). The engine has no batch API: the throughput is the same as with 1, only the reported latency changes (each frame is timed from the start to the end of its batch). Not accepted by --sweep, as it has nothing to tune. Default: 1.\n\n"
 		"--rate: Percentage value within[0.0, 1.0] defining the positive rate. The positive rate defines the percentage of images with a plate.\n\n"
 		"--parallel: Whether to enabled the parallel mode. More info about the parallel mode at https ://www.doubango.org/SDKs/anpr/docs/Parallel_versus_sequential_processing.html. Default: true.\n\n"
 		"--rectify: Whether to enable the rectification layer. More info about the rectification layer at https://www.doubango.org/SDKs/anpr/docs/Rectification_layer.html. Default: false.\n\n"
@@ -26,6 +26,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
 #include <memory>
 #include <chrono>
 #include <thread>
@@ -36,6 +37,9 @@
 
 // Include the ultimateALPR SDK header
 #include "ultimateALPR-SDK-API-PUBLIC.h"
+#include "../alpr_engine.h"
+#include "../alpr_plates.h"
+#include "../alpr_tracker.h"
 
 using json = nlohmann::json;
 namespace fs = std::filesystem;
@@ -55,10 +59,18 @@ cv::Size imageSize(1280, 720);
 int count = 0;
 ULTALPR_SDK_IMAGE_TYPE format = ULTALPR_SDK_IMAGE_TYPE_BGR24;
 
-// Car tracking data structures
-std::map<std::string, std::shared_ptr<class Car>> detectedCars;
-std::map<std::string, std::shared_ptr<class Car>> lastFrameCars;
-std::map<std::string, std::shared_ptr<class Car>> currFrameCars;
+// Engine handle for this video: the models are shared with the other instances, if any (see alpr_engine.h)
+AlprEngineInstance engine;
+
+// Car tracking data structures, keyed by track id
+AlprTracker tracker;
+std::map<uint64_t, std::shared_ptr<class Car>> detectedCars;
+std::map<uint64_t, std::shared_ptr<class Car>> currFrameCars;
+
+// Converts a fixed-size warped box (see AlprPlate) to the representation used for tracking
+std::vector<double> toBox(const float (&box)[8]) {
+    return std::vector<double>(box, box + 8);
+}
 
 // Car class to represent detected vehicles
 class Car {
@@ -78,10 +90,10 @@ public:
     bool countSet;
     int frameNo;
 
-    Car(const json& detection, int frameNumber) 
-        : text(detection["text"]), 
-          plateCoordinates(detection["warpedBox"]),
-          carCoordinates(detection["car"]["warpedBox"]),
+    Car(const AlprPlate& detection, int frameNumber) 
+        : text(detection.text), 
+          plateCoordinates(toBox(detection.warpedBox)),
+          carCoordinates(toBox(detection.carWarpedBox)),
           carId(id++),
           speed(0.0),
           countSet(false),
@@ -95,10 +107,9 @@ public:
     std::vector<double> getCarCoordinates() const { return carCoordinates; }
     std::vector<double> getPlateCoordinates() const { return plateCoordinates; }
 
-    void setSpeed(const json& detection, int frameNo) {
-        std::vector<double> newCarCoordinates = detection["car"]["warpedBox"];
+    void setSpeed(const AlprPlate& detection, int frameNo) {
         double v1 = (carCoordinates[1] + carCoordinates[7]) / 2.0;
-        double v2 = (newCarCoordinates[1] + newCarCoordinates[7]) / 2.0;
+        double v2 = (detection.carWarpedBox[1] + detection.carWarpedBox[7]) / 2.0;
         int t = this->frameNo - frameNo;
         if (t != 0) {
             double newSpeed = std::abs((v1 - v2) / t);
@@ -108,7 +119,7 @@ public:
         }
     }
 
-    void setCount(const json* detection = nullptr) {
+    void setCount(const AlprPlate* detection = nullptr) {
         if (countSet) return;
 
         double a1 = checkBoxout.first;
@@ -117,7 +128,7 @@ public:
         double b2 = checkBoxin.second;
 
         if (detection) {
-            carCoordinates = (*detection)["car"]["warpedBox"];
+            carCoordinates = toBox(detection->carWarpedBox);
         }
 
         double carCenterX = (carCoordinates[0] + carCoordinates[2]) / 2.0;
@@ -147,77 +158,26 @@ int Car::outgoingCount = 0;
 std::pair<double, double> Car::checkBoxout = {0.554, 0.60};
 std::pair<double, double> Car::checkBoxin = {0.36, 0.41};
 
-// Intersection over Union of two bounding boxes
-double IOU(const std::vector<double>& boxA, const std::vector<double>& boxB) {
-    // Determine the (x, y)-coordinates of the intersection rectangle
-    double xA = std::max(boxA[0], boxB[0]);
-    double yA = std::max(boxA[1], boxB[1]);
-    double xB = std::min(boxA[4], boxB[4]);
-    double yB = std::min(boxA[5], boxB[5]);
-
-    // Compute the area of intersection rectangle
-    double interArea = std::max(0.0, xB - xA) * std::max(0.0, yB - yA);
-
-    // Compute the area of both the prediction and ground-truth rectangles
-    double boxAArea = (boxA[2] - boxA[0]) * (boxA[7] - boxA[1]);
-    double boxBArea = (boxB[2] - boxB[0]) * (boxB[7] - boxB[1]);
-
-    // Compute the intersection over union
-    double iou = interArea / (boxAArea + boxBArea - interArea);
-    return iou;
-}
-
 // Operate function to handle car detection and tracking
-void operate(const json& detection, int frameNo) {
-    std::string text = detection["text"];
-    
-    // Check if this text is already detected
-    if (detectedCars.find(text) != detectedCars.end()) {
-        auto& car = detectedCars[text];
+void operate(const AlprTrack& track, int frameNo) {
+    const AlprPlate& detection = track.plate;
+    auto it = detectedCars.find(track.id);
+    if (it != detectedCars.end()) {
+        auto& car = it->second;
         car->setSpeed(detection, frameNo);
         if (!car->isCountSet()) {
             car->setCount(&detection);
         }
         car->frameNo = frameNo;
-        car->carCoordinates = detection["car"]["warpedBox"];
-        car->plateCoordinates = detection["warpedBox"];
-        currFrameCars[text] = car;
+        car->text = track.text; // Frozen once the track is confirmed
+        car->carCoordinates = toBox(detection.carWarpedBox);
+        car->plateCoordinates = toBox(detection.warpedBox);
+        currFrameCars[track.id] = car;
     } else {
-        // Check if this car has IOU > 0.58 with any previously detected cars
-        bool flag = false;
-        std::vector<double> carCoordinates = detection["car"]["warpedBox"];
-        
-        for (auto it = lastFrameCars.begin(); it != lastFrameCars.end(); ++it) {
-            auto& lfc = it->second;
-            double iou = IOU(lfc->carCoordinates, carCoordinates);
-            if (iou >= 0.58) {
-                lfc->setSpeed(detection, frameNo);
-                lfc->frameNo = frameNo;
-                lfc->carCoordinates = carCoordinates;
-                lfc->plateCoordinates = detection["warpedBox"];
-                
-                std::string oldText = it->first;
-                std::string modifiedText = (oldText > text) ? oldText : text;
-                lfc->text = modifiedText;
-                
-                lastFrameCars.erase(it);
-                detectedCars.erase(oldText);
-                detectedCars[modifiedText] = lfc;
-                currFrameCars[modifiedText] = lfc;
-                
-                if (!lfc->isCountSet()) {
-                    lfc->setCount();
-                }
-                flag = true;
-                break;
-            }
-        }
-        
-        if (!flag) {
-            auto newCar = std::make_shared<Car>(detection, frameNo);
-            detectedCars[text] = newCar;
-            currFrameCars[text] = newCar;
-        }
+        auto newCar = std::make_shared<Car>(detection, frameNo);
+        newCar->text = track.text;
+        detectedCars[track.id] = newCar;
+        currFrameCars[track.id] = newCar;
     }
 }
 
@@ -236,36 +196,40 @@ std::pair<std::vector<std::string>, std::vector<std::pair<std::vector<double>, s
 }
 
 // Check result helper function
+bool checkResult(const std::string& operation, const UltAlprSdkResult& result) {
+    if (!result.isOK()) {
+        std::cout << TAG << operation << ": failed -> " << result.phrase() << std::endl;
+    }
+    return result.isOK();
+}
+
+// Tracks the plates from a process() result, frameNo being the video frame number
 std::pair<std::vector<std::pair<std::vector<double>, std::vector<double>>>, std::vector<std::string>> 
-checkResult(const std::string& operation, const UltAlprSdkResult& result) {
+trackResult(const UltAlprSdkResult& result, const AlprPlates& plates, int frameNo) {
     std::vector<std::pair<std::vector<double>, std::vector<double>>> warpedBoxes;
     std::vector<std::string> texts_lst;
     
-    if (!result.isOK()) {
-        std::cout << TAG << operation << ": failed -> " << result.phrase() << std::endl;
-    } else {
-        try {
-            json data = json::parse(result.json());
-            if (data.contains("plates")) {
-                std::cout << data["frame_id"] << std::endl;
-                for (const auto& plate : data["plates"]) {
-                    if (plate.contains("car")) {
-                        std::cout << "car : " << plate["text"] << std::endl;
-                        operate(plate, data["frame_id"]);
-                    }
-                }
-            }
-            auto result_pair = getTW();
-            texts_lst = result_pair.first;
-            warpedBoxes = result_pair.second;
-            std::cout << "Detected texts: ";
-            for (const auto& text : texts_lst) {
-                std::cout << text << " ";
+    if (checkResult("Process", result)) {
+        if (!plates.empty()) {
+            std::cout << frameNo << std::endl;
+        }
+        // Stable track ids across frames: the same vehicle keeps its id (and text) even if a read differs
+        const std::vector<uint64_t>& trackIds = tracker.update(plates, frameNo);
+        for (size_t i = 0; i < plates.size(); ++i) {
+            if (plates[i].hasCar) {
+                const AlprTrack* track = tracker.track(trackIds[i]);
+                std::cout << "car #" << track->id << " : " << track->text << (track->confirmed ? " (confirmed)" : "") << std::endl;
+                operate(*track, frameNo);
             }
-            std::cout << std::endl;
-        } catch (const json::exception& e) {
-            std::cerr << "JSON parsing error: " << e.what() << std::endl;
         }
+        auto result_pair = getTW();
+        texts_lst = result_pair.first;
+        warpedBoxes = result_pair.second;
+        std::cout << "Detected texts: ";
+        for (const auto& text : texts_lst) {
+            std::cout << text << " ";
+        }
+        std::cout << std::endl;
     }
     
     return {warpedBoxes, texts_lst};
@@ -295,7 +259,7 @@ json getDefaultConfig() {
 
 // Main predict function
 std::pair<std::vector<std::pair<std::vector<double>, std::vector<double>>>, std::vector<std::string>> 
-predict(const cxxopts::ParseResult& args, const cv::Mat& frame) {
+predict(const cxxopts::ParseResult& args, const cv::Mat& frame, int frameNo) {
     static bool initialized = false;
     
     if (!initialized) {
@@ -315,7 +279,7 @@ predict(const cxxopts::ParseResult& args, const cv::Mat& frame) {
         config["license_token_data"] = args["tokendata"].as<std::string>();
 
         // Initialize the engine
-        checkResult("Init", UltAlprSdkEngine::init(config.dump().c_str()));
+        checkResult("Init", engine.init(config.dump().c_str()));
         initialized = true;
     }
 
@@ -324,16 +288,15 @@ predict(const cxxopts::ParseResult& args, const cv::Mat& frame) {
     cv::cvtColor(frame, rgbFrame, cv::COLOR_BGR2RGB);
     
     // Process the frame
-    return checkResult("Process", 
-        UltAlprSdkEngine::process(
-            format,
-            rgbFrame.data,
-            rgbFrame.cols,
-            rgbFrame.rows,
-            0, // stride
-            1  // exifOrientation
-        )
-    );
+    AlprFrame alprFrame;
+    alprFrame.type = format;
+    alprFrame.data[0] = rgbFrame.data;
+    alprFrame.width = rgbFrame.cols;
+    alprFrame.height = rgbFrame.rows;
+    // Reused across frames: no DOM and no per-frame allocation once the vector is warm
+    static AlprPlates plates;
+    const UltAlprSdkResult result = engine.process(alprFrame, plates);
+    return trackResult(result, plates, frameNo);
 }
 
 // Check FPS of input video
@@ -438,11 +401,13 @@ cv::Mat displayInCv2(const std::vector<std::pair<std::vector<double>, std::vecto
                          cv::Scalar(0, 255, 0), 2);
             
             // Draw speed
-            if (currFrameCars.find(text) != currFrameCars.end()) {
-                double speed = currFrameCars[text]->getSpeed();
+            for (const auto& pair : currFrameCars) {
+                if (pair.second->getText() != text) continue;
+                double speed = pair.second->getSpeed();
                 std::string speedText = std::to_string(speed).substr(0, std::to_string(speed).find('.') + 3);
                 cv::putText(frame, speedText, cv::Point(box2[0], box2[1]), 
                            cv::FONT_HERSHEY_TRIPLEX, 0.7, cv::Scalar(0, 200, 255), 1, cv::LINE_AA);
+                break;
             }
         }
     }
@@ -539,14 +504,13 @@ int main(int argc, char* argv[]) {
                 frame_count++;
                 
                 // Process frame
-                auto [warpedBox, texts] = predict(args, frame);
+                auto [warpedBox, texts] = predict(args, frame, frame_count);
                 
                 // Display and save frame
                 frame = displayInCv2(warpedBox, texts, frame);
                 savedVideo.write(frame);
                 
                 // Update tracking
-                lastFrameCars = currFrameCars;
                 currFrameCars.clear();
                 
                 // Print progress every 100 frames
@@ -567,12 +531,16 @@ int main(int argc, char* argv[]) {
         savedVideo.release();
         
         // Deinitialize the engine
-        checkResult("DeInit", UltAlprSdkEngine::deInit());
+        checkResult("DeInit", engine.deInit());
         
-        // Save detected number plates
+        // Save detected number plates, once per text: a vehicle whose track was lost and re-acquired
+        // gets a new track id (hence a second entry in detectedCars) with the same confirmed text
         std::vector<std::string> numberplates;
+        std::set<std::string> written;
         for (const auto& pair : detectedCars) {
-            numberplates.push_back(pair.first);
+            if (written.insert(pair.second->getText()).second) {
+                numberplates.push_back(pair.second->getText());
+            }
         }
         
         std::ofstream outFile("numberplates.txt");